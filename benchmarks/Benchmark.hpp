@@ -0,0 +1,112 @@
+#pragma once
+
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <EasyWindow/Global.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+struct BenchmarkResult
+{
+    std::string
+    name {};
+
+    std::string
+    unit {};                    // what one operation is
+
+    std::uint64_t
+    operations {0};
+
+    std::uint64_t
+    nanoseconds {0};
+
+    double
+    nanosecondsPerOperation() const
+    {
+        return operations ? double(nanoseconds) / double(operations) : 0.0;
+    }
+
+    double
+    operationsPerSecond() const
+    {
+        return nanoseconds ? double(operations) * 1e9 / double(nanoseconds) : 0.0;
+    }
+};
+
+/* --------------------------------------------------------------------------------------- */
+
+/**
+ * Minimal benchmark registry. Results are printed as table to stderr and as
+ * JSON to stdout (or file), so they can be compared between releases.
+ */
+class Benchmarks
+{
+
+/* ####################################################################################### */
+public: /* Methods */
+/* ####################################################################################### */
+
+    /**
+     * Measure function called 'operations' times in total.
+     * @param name Benchmark name.
+     * @param unit Operation name.
+     * @param operations Operations count the function performs.
+     * @param func Function to measure.
+     * @return Measured result.
+     */
+    template<typename Func>
+    const BenchmarkResult&
+    run(const std::string& name, const std::string& unit, std::uint64_t operations, Func&& func)
+    {
+        const auto start = nowNanoseconds();
+        func();
+        const auto duration = nowNanoseconds() - start;
+
+        m_results.push_back({name, unit, operations, duration});
+
+        const auto& r = m_results.back();
+        std::fprintf(stderr, "%-32s %14.1f ns/%-8s %16.1f %s/s\n",
+            r.name.c_str(), r.nanosecondsPerOperation(), r.unit.c_str(), r.operationsPerSecond(), r.unit.c_str());
+
+        return r;
+    }
+
+    /**
+     * Write results as JSON.
+     * @param file Output stream.
+     */
+    void
+    writeJson(std::FILE* file) const
+    {
+        std::fprintf(file, "{\"benchmarks\":[");
+
+        for (std::size_t i = 0; i < m_results.size(); ++i)
+        {
+            const auto& r = m_results[i];
+            std::fprintf(file, "%s{\"name\":\"%s\",\"unit\":\"%s\",\"operations\":%llu,\"ns_total\":%llu,\"ns_per_op\":%.3f,\"ops_per_sec\":%.3f}",
+                i ? "," : "",
+                r.name.c_str(),
+                r.unit.c_str(),
+                static_cast<unsigned long long>(r.operations),
+                static_cast<unsigned long long>(r.nanoseconds),
+                r.nanosecondsPerOperation(),
+                r.operationsPerSecond());
+        }
+
+        std::fprintf(file, "]}\n");
+    }
+
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    std::vector<BenchmarkResult>
+    m_results {};
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,788 @@
+#include "Benchmark.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <EasyWindow/Window.hpp>
+#include <EasyWindow/BasicWindow.hpp>
+
+#ifdef EZWINDOW_OPENGL
+    #include <GL/glew.h>
+#endif
+
+#include <GLFW/glfw3.h>
+
+
+using namespace EZWINDOW;
+
+namespace
+{
+    /** Keeps results alive, so compiler can't throw measured code away */
+    volatile std::uint64_t sink = 0;
+
+    class BenchWindow : public Window
+    {
+    public:
+        BenchWindow()
+            : Window(EOriginCorner::TopLeft)
+        {
+
+        }
+
+        std::uint64_t
+        handled {0};
+
+    protected:
+        void
+        tickEvent() override
+        {
+
+        }
+
+        void
+        keyEvent(EKey key, EState state, EModifier modifier) override
+        {
+            handled += std::uint64_t(key);
+        }
+
+        void
+        mouseMoveEvent(Vector<uint64_t> position) override
+        {
+            handled += position.x;
+        }
+
+        void
+        buttonEvent(EButton button, EState state, EModifier modifier) override
+        {
+            handled += std::uint64_t(button);
+        }
+    };
+
+    /* ----------------------------------------------------------------------------------- */
+
+    class StaticBenchWindow : public BasicWindow<StaticBenchWindow>
+    {
+        friend BasicWindow<StaticBenchWindow>;
+
+    public:
+        StaticBenchWindow()
+            : BasicWindow(EOriginCorner::TopLeft)
+        {
+
+        }
+
+        std::uint64_t
+        handled {0};
+
+    protected:
+        void
+        tickEvent() override
+        {
+
+        }
+
+        void
+        keyEvent(EKey key, EState state, EModifier modifier) override
+        {
+            handled += std::uint64_t(key);
+        }
+    };
+
+    /* ----------------------------------------------------------------------------------- */
+
+#ifdef EZWINDOW_OPENGL
+    class StreamBenchWindow : public Window
+    {
+    public:
+        StreamBenchWindow()
+            : Window(EOriginCorner::TopLeft)
+        {
+
+        }
+
+        std::uint64_t
+        uploadSize {0};
+
+        std::uint32_t
+        target {0};         // GPU side copy of uploads, so regions are really in flight
+
+    protected:
+        void
+        tickEvent() override
+        {
+
+        }
+
+        void
+        renderEvent() override
+        {
+            GLStreamBuffer& stream = *streamBuffer();
+            const StreamAllocation allocation = stream.allocate(uploadSize);
+
+            if (allocation.data)
+            {
+                std::memset(allocation.data, int(clock().frame() & 0xff), uploadSize);
+                glCopyNamedBufferSubData(stream.buffer(), target, GLintptr(allocation.offset), 0, GLsizeiptr(uploadSize));
+            }
+
+            swapFrameBuffers();
+        }
+    };
+#endif
+
+    /* ----------------------------------------------------------------------------------- */
+
+#ifdef EZWINDOW_VULKAN
+    /**
+     * Renders empty frames into window swapchain, on the first device presenting to
+     * the window (lavapipe on machines without GPU).
+     */
+    class SwapchainBenchWindow : public Window
+    {
+    public:
+        SwapchainBenchWindow()
+            : Window(EOriginCorner::TopLeft)
+        {
+
+        }
+
+        ~SwapchainBenchWindow() override
+        {
+            if (m_device)
+            {
+                vkDeviceWaitIdle(m_device);
+            }
+
+            destroyVulkanSwapchain();
+
+            if (m_commandPool)
+            {
+                vkDestroyCommandPool(m_device, m_commandPool, nullptr);
+            }
+
+            if (m_device)
+            {
+                vkDestroyDevice(m_device, nullptr);
+            }
+
+            if (m_surface)
+            {
+                vkDestroySurfaceKHR(m_instance, m_surface, nullptr);
+            }
+
+            if (m_instance)
+            {
+                vkDestroyInstance(m_instance, nullptr);
+            }
+        }
+
+        bool
+        initialize(std::uint32_t framesInFlight)
+        {
+            const std::vector<std::string> names = vulkanExtensions();
+            std::vector<const char*> extensions;
+
+            for (const auto& name : names)
+            {
+                extensions.push_back(name.c_str());
+            }
+
+            VkApplicationInfo application {};
+            application.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+            application.pApplicationName = "EasyWindowBench";
+            application.apiVersion = VK_API_VERSION_1_0;
+
+            VkInstanceCreateInfo instanceInfo {};
+            instanceInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+            instanceInfo.pApplicationInfo = &application;
+            instanceInfo.enabledExtensionCount = std::uint32_t(extensions.size());
+            instanceInfo.ppEnabledExtensionNames = extensions.data();
+
+            if (vkCreateInstance(&instanceInfo, nullptr, &m_instance) != VK_SUCCESS)
+            {
+                return false;
+            }
+
+            if (createVulkanSurface(&m_instance, &m_surface, nullptr) != VK_SUCCESS)
+            {
+                return false;
+            }
+
+            VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+            std::uint32_t queueFamily = 0;
+
+            if (!findDevice(physicalDevice, queueFamily))
+            {
+                return false;
+            }
+
+            const float priority = 1.0f;
+
+            VkDeviceQueueCreateInfo queueInfo {};
+            queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+            queueInfo.queueFamilyIndex = queueFamily;
+            queueInfo.queueCount = 1;
+            queueInfo.pQueuePriorities = &priority;
+
+            const char* deviceExtensions[] = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
+
+            VkDeviceCreateInfo deviceInfo {};
+            deviceInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+            deviceInfo.queueCreateInfoCount = 1;
+            deviceInfo.pQueueCreateInfos = &queueInfo;
+            deviceInfo.enabledExtensionCount = 1;
+            deviceInfo.ppEnabledExtensionNames = deviceExtensions;
+
+            if (vkCreateDevice(physicalDevice, &deviceInfo, nullptr, &m_device) != VK_SUCCESS)
+            {
+                return false;
+            }
+
+            vkGetDeviceQueue(m_device, queueFamily, 0, &m_queue);
+
+            VkCommandPoolCreateInfo poolInfo {};
+            poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+            poolInfo.queueFamilyIndex = queueFamily;
+
+            if (vkCreateCommandPool(m_device, &poolInfo, nullptr, &m_commandPool) != VK_SUCCESS)
+            {
+                return false;
+            }
+
+            m_commandBuffers.resize(framesInFlight);
+
+            VkCommandBufferAllocateInfo allocateInfo {};
+            allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocateInfo.commandPool = m_commandPool;
+            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.commandBufferCount = framesInFlight;
+
+            if (vkAllocateCommandBuffers(m_device, &allocateInfo, m_commandBuffers.data()) != VK_SUCCESS)
+            {
+                return false;
+            }
+
+            VulkanSwapchainConfig config;
+            config.physicalDevice = physicalDevice;
+            config.device = m_device;
+            config.presentQueue = m_queue;
+            config.surface = m_surface;
+            config.framesInFlight = framesInFlight;
+            config.presentMode = EPresentMode::Immediate;
+
+            createVulkanSwapchain(config);
+
+            return true;
+        }
+
+    protected:
+        void
+        tickEvent() override
+        {
+
+        }
+
+        void
+        renderEvent() override
+        {
+            VulkanSwapchain& swapchain = *vulkanSwapchain();
+
+            VulkanFrame frame;
+            if (!swapchain.acquire(frame))
+            {
+                return;
+            }
+
+            VkCommandBuffer commandBuffer = m_commandBuffers[frame.slot];
+            vkResetCommandBuffer(commandBuffer, 0);
+
+            VkCommandBufferBeginInfo beginInfo {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+            // Nothing is drawn, image only goes to present layout
+            VkImageMemoryBarrier barrier {};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            barrier.dstAccessMask = 0;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = frame.image;
+            barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+
+            vkCmdPipelineBarrier(commandBuffer,
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+            vkEndCommandBuffer(commandBuffer);
+
+            const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+
+            VkSubmitInfo submitInfo {};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.waitSemaphoreCount = 1;
+            submitInfo.pWaitSemaphores = &frame.acquired;
+            submitInfo.pWaitDstStageMask = &waitStage;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &commandBuffer;
+            submitInfo.signalSemaphoreCount = 1;
+            submitInfo.pSignalSemaphores = &frame.rendered;
+
+            vkQueueSubmit(m_queue, 1, &submitInfo, frame.fence);
+            swapchain.present(frame);
+        }
+
+    private:
+        bool
+        findDevice(VkPhysicalDevice& physicalDevice, std::uint32_t& queueFamily) const
+        {
+            std::uint32_t count = 0;
+            vkEnumeratePhysicalDevices(m_instance, &count, nullptr);
+
+            std::vector<VkPhysicalDevice> devices(count);
+            vkEnumeratePhysicalDevices(m_instance, &count, devices.data());
+
+            for (VkPhysicalDevice device : devices)
+            {
+                std::uint32_t familiesCount = 0;
+                vkGetPhysicalDeviceQueueFamilyProperties(device, &familiesCount, nullptr);
+
+                std::vector<VkQueueFamilyProperties> families(familiesCount);
+                vkGetPhysicalDeviceQueueFamilyProperties(device, &familiesCount, families.data());
+
+                for (std::uint32_t i = 0; i < familiesCount; ++i)
+                {
+                    VkBool32 present = VK_FALSE;
+                    vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_surface, &present);
+
+                    if (present && (families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT))
+                    {
+                        physicalDevice = device;
+                        queueFamily = i;
+                        return true;
+                    }
+                }
+            }
+
+            return false;
+        }
+
+        VkInstance
+        m_instance {VK_NULL_HANDLE};
+
+        VkSurfaceKHR
+        m_surface {VK_NULL_HANDLE};
+
+        VkDevice
+        m_device {VK_NULL_HANDLE};
+
+        VkQueue
+        m_queue {VK_NULL_HANDLE};
+
+        VkCommandPool
+        m_commandPool {VK_NULL_HANDLE};
+
+        std::vector<VkCommandBuffer>
+        m_commandBuffers {};    // per frame in flight
+    };
+#endif
+
+    /* ----------------------------------------------------------------------------------- */
+
+    void
+    benchStartup(Benchmarks& benchmarks)
+    {
+        constexpr std::uint64_t count = 20;
+
+        benchmarks.run("window_create_destroy", "window", count, []
+        {
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                BenchWindow window;
+                sink = sink + window.size().w;
+            }
+        });
+    }
+
+    /* ----------------------------------------------------------------------------------- */
+
+    void
+    benchLoop(Benchmarks& benchmarks, BenchWindow& window)
+    {
+        constexpr std::uint64_t count = 100000;
+
+        benchmarks.run("empty_loop", "frame", count, [&]
+        {
+            window.runFrames(count);
+        });
+    }
+
+    /* ----------------------------------------------------------------------------------- */
+
+    template<typename BenchWindowType, typename Invoke>
+    void
+    benchCallback(Benchmarks& benchmarks, BenchWindowType& window, const char* name, Invoke&& invoke)
+    {
+        constexpr std::uint64_t batches = 1000;
+        constexpr std::uint64_t batch = 512;    // fits into window event queue
+
+        benchmarks.run(name, "event", batches * batch, [&]
+        {
+            for (std::uint64_t b = 0; b < batches; ++b)
+            {
+                for (std::uint64_t i = 0; i < batch; ++i)
+                {
+                    invoke(i);
+                }
+
+                window.runFrames(1);
+            }
+        });
+
+        sink = sink + window.handled;
+    }
+
+    /* ----------------------------------------------------------------------------------- */
+
+    void
+    benchCallbacks(Benchmarks& benchmarks, BenchWindow& window)
+    {
+        GLFWwindow* handle = window.glfwWindow();
+
+        // GLFW returns previous callback, this is the one registered by Window
+        const auto keyCallback = glfwSetKeyCallback(handle, nullptr);
+        const auto cursorCallback = glfwSetCursorPosCallback(handle, nullptr);
+        const auto buttonCallback = glfwSetMouseButtonCallback(handle, nullptr);
+
+        glfwSetKeyCallback(handle, keyCallback);
+        glfwSetCursorPosCallback(handle, cursorCallback);
+        glfwSetMouseButtonCallback(handle, buttonCallback);
+
+        benchCallback(benchmarks, window, "key_callback_dispatch", [&](std::uint64_t i)
+        {
+            keyCallback(handle, GLFW_KEY_A, 0, int(i & 1), 0);
+        });
+
+        benchCallback(benchmarks, window, "cursor_callback_dispatch", [&](std::uint64_t i)
+        {
+            cursorCallback(handle, double(i % 640), double(i % 480));
+        });
+
+        window.setMouseMotionCoalescing(true);
+
+        benchCallback(benchmarks, window, "cursor_callback_coalesced", [&](std::uint64_t i)
+        {
+            cursorCallback(handle, double(i % 640), double(i % 480));
+        });
+
+        window.setMouseMotionCoalescing(false);
+
+        benchCallback(benchmarks, window, "button_callback_dispatch", [&](std::uint64_t i)
+        {
+            buttonCallback(handle, GLFW_MOUSE_BUTTON_LEFT, int(i & 1), 0);
+        });
+    }
+
+    /* ----------------------------------------------------------------------------------- */
+
+    void
+    benchStaticCallbacks(Benchmarks& benchmarks, StaticBenchWindow& window)
+    {
+        GLFWwindow* handle = window.glfwWindow();
+
+        const auto keyCallback = glfwSetKeyCallback(handle, nullptr);
+        glfwSetKeyCallback(handle, keyCallback);
+
+        benchCallback(benchmarks, window, "key_callback_static_dispatch", [&](std::uint64_t i)
+        {
+            keyCallback(handle, GLFW_KEY_A, 0, int(i & 1), 0);
+        });
+    }
+
+    /* ----------------------------------------------------------------------------------- */
+
+    void
+    benchGetters(Benchmarks& benchmarks, BenchWindow& window)
+    {
+        constexpr std::uint64_t count = 10000000;
+
+        benchmarks.run("mouse_offset", "call", count, [&]
+        {
+            double sum = 0;
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                sum += window.mouseOffset().rel01Value.x;
+            }
+            sink = sink + std::uint64_t(sum);
+        });
+
+        benchmarks.run("key_state", "call", count, [&]
+        {
+            std::uint64_t sum = 0;
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                sum += std::uint64_t(window.keyState(EKey(65 + i % 26)));
+            }
+            sink = sink + sum;
+        });
+
+        benchmarks.run("input_is_down", "call", count, [&]
+        {
+            std::uint64_t sum = 0;
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                sum += window.input().isDown(EKey(i % 349));
+            }
+            sink = sink + sum;
+        });
+
+        benchmarks.run("relative", "call", count, [&]
+        {
+            double sum = 0;
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                sum += window.relative<double>({i % 1280, i % 720}).x;
+            }
+            sink = sink + std::uint64_t(sum);
+        });
+
+        benchmarks.run("relative01", "call", count, [&]
+        {
+            double sum = 0;
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                sum += window.relative01<double>({i % 1280, i % 720}).x;
+            }
+            sink = sink + std::uint64_t(sum);
+        });
+    }
+
+    /* ----------------------------------------------------------------------------------- */
+
+#ifdef EZWINDOW_OPENGL
+    void
+    benchStreamBuffer(Benchmarks& benchmarks)
+    {
+        constexpr std::uint64_t count = 2000;
+        constexpr std::uint64_t uploadSize = 1 << 20;
+
+        StreamBenchWindow window;
+        window.uploadSize = uploadSize;
+
+        glCreateBuffers(1, &window.target);
+        glNamedBufferStorage(window.target, GLsizeiptr(uploadSize), nullptr, 0);
+
+        const GLStreamBuffer& stream = window.createStreamBuffer(uploadSize);
+
+        benchmarks.run("stream_buffer_frame", "frame", count, [&]
+        {
+            window.runFrames(count);
+        });
+
+        const StreamStats& stats = stream.stats();
+
+        std::fprintf(stderr, "%-32s %14llu of %llu frames, %.3f ms waited, %llu failed allocations\n",
+            "stream_buffer_stalls",
+            static_cast<unsigned long long>(stats.stalls),
+            static_cast<unsigned long long>(count),
+            stats.stallTime * 1e3,
+            static_cast<unsigned long long>(stats.failedAllocations));
+
+        window.destroyStreamBuffer();
+        glDeleteBuffers(1, &window.target);
+    }
+#endif
+
+    /* ----------------------------------------------------------------------------------- */
+
+#ifdef EZWINDOW_VULKAN
+    void
+    benchVulkanSwapchain(Benchmarks& benchmarks)
+    {
+        constexpr std::uint64_t count = 2000;
+        constexpr std::uint64_t resizes = 200;
+        constexpr std::uint32_t framesInFlight = 2;
+
+        SwapchainBenchWindow window;
+
+        if (!window.initialize(framesInFlight))
+        {
+            std::fprintf(stderr, "%-32s skipped, no Vulkan device presents to window\n", "vulkan_swapchain");
+            return;
+        }
+
+        const VulkanSwapchain& swapchain = *window.vulkanSwapchain();
+
+        benchmarks.run("vulkan_swapchain_frame", "frame", count, [&]
+        {
+            window.runFrames(count);
+        });
+
+        const std::uint64_t recreations = swapchain.recreationsCount();
+
+        // Every resize recreates swapchain through 'oldSwapchain' while previous frames are in flight
+        benchmarks.run("vulkan_swapchain_resize", "resize", resizes, [&]
+        {
+            for (std::uint64_t i = 0; i < resizes; ++i)
+            {
+                window.injectResize({640 + (i % 2) * 160, 480 + (i % 2) * 120});
+                window.runFrames(1);
+            }
+        });
+
+        // Retired swapchains are destroyed once frames in flight passed them
+        window.runFrames(framesInFlight + 1);
+
+        std::fprintf(stderr, "%-32s %14llu of %llu resizes, %u retired left, %ux%u images\n",
+            "vulkan_swapchain_recreations",
+            static_cast<unsigned long long>(swapchain.recreationsCount() - recreations),
+            static_cast<unsigned long long>(resizes),
+            swapchain.retiredCount(),
+            swapchain.extent().width,
+            swapchain.extent().height);
+    }
+#endif
+
+    /* ----------------------------------------------------------------------------------- */
+
+    void
+    benchCursorSnapshot(Benchmarks& benchmarks, BenchWindow& window)
+    {
+        // Same calls count on both sides, on a real platform GLFW queries go to the window system
+        constexpr std::uint64_t count = 100000;
+
+        const auto& snapshot = benchmarks.run("mouse_position", "call", count, [&]
+        {
+            std::uint64_t sum = 0;
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                sum += window.mousePosition().x;
+            }
+            sink = sink + sum;
+        });
+        const double snapshotTime = snapshot.nanosecondsPerOperation();
+
+        const auto& hoverSnapshot = benchmarks.run("is_mouse_in_window", "call", count, [&]
+        {
+            std::uint64_t sum = 0;
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                sum += window.isMouseInWindow();
+            }
+            sink = sink + sum;
+        });
+        const double hoverSnapshotTime = hoverSnapshot.nanosecondsPerOperation();
+
+#ifdef GLFW_PLATFORM_NULL
+        // Null platform answers from memory, the comparison would measure nothing
+        if (glfwGetPlatform() == GLFW_PLATFORM_NULL)
+        {
+            std::fprintf(stderr, "%-32s skipped, null platform, run with --visible\n", "glfw_cursor_queries");
+            return;
+        }
+#endif
+
+        const auto& query = benchmarks.run("glfw_get_cursor_pos", "call", count, [&]
+        {
+            double x = 0;
+            double y = 0;
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                glfwGetCursorPos(window.glfwWindow(), &x, &y);
+            }
+            sink = sink + std::uint64_t(x + y);
+        });
+
+        std::fprintf(stderr, "%-32s %14.1fx\n", "cursor_snapshot_speedup", query.nanosecondsPerOperation() / std::max(snapshotTime, 1e-3));
+
+        const auto& hoverQuery = benchmarks.run("glfw_get_hovered", "call", count, [&]
+        {
+            std::uint64_t sum = 0;
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                sum += std::uint64_t(glfwGetWindowAttrib(window.glfwWindow(), GLFW_HOVERED));
+            }
+            sink = sink + sum;
+        });
+
+        std::fprintf(stderr, "%-32s %14.1fx\n", "hover_snapshot_speedup", hoverQuery.nanosecondsPerOperation() / std::max(hoverSnapshotTime, 1e-3));
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+int
+main(int argc, char** argv)
+{
+    const char* output = nullptr;
+    bool headless = true;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--visible") == 0)
+        {
+            headless = false;
+        }
+        else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+        {
+            output = argv[++i];
+        }
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--visible] [--out results.json]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    Window::setHeadless(headless);
+
+    Benchmarks benchmarks;
+
+    benchStartup(benchmarks);
+
+    {
+        BenchWindow window;
+
+        benchLoop(benchmarks, window);
+        benchCallbacks(benchmarks, window);
+        benchGetters(benchmarks, window);
+        benchCursorSnapshot(benchmarks, window);
+    }
+
+    {
+        StaticBenchWindow window;
+
+        benchStaticCallbacks(benchmarks, window);
+    }
+
+#ifdef EZWINDOW_OPENGL
+    benchStreamBuffer(benchmarks);
+#endif
+
+#ifdef EZWINDOW_VULKAN
+    benchVulkanSwapchain(benchmarks);
+#endif
+
+    std::FILE* file = output ? std::fopen(output, "w") : stdout;
+
+    if (!file)
+    {
+        std::fprintf(stderr, "cant open %s\n", output);
+        return 1;
+    }
+
+    benchmarks.writeJson(file);
+
+    if (output)
+    {
+        std::fclose(file);
+    }
+
+    return 0;
+}
\ No newline at end of file
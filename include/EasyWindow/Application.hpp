@@ -0,0 +1,182 @@
+#pragma once
+
+
+#include <memory>
+#include <vector>
+#include <EasyWindow/Window.hpp>
+#include <EasyWindow/FramePacer.hpp>
+#include <EasyWindow/Enums/FramePacing.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/**
+ * Owns several windows and drives all of them by single event loop. Events are
+ * pumped once per iteration, then each window runs its tick/clear/render in turn.
+ * Window's own pacing and render thread settings are ignored, application paces
+ * the whole iteration instead.
+ */
+class Application
+{
+
+/* ####################################################################################### */
+public: /* Constructors */
+/* ####################################################################################### */
+
+    ~Application();
+
+    Application();
+
+    Application(const Application&) = delete;
+
+    Application&
+    operator=(const Application&) = delete;
+
+/* ####################################################################################### */
+public: /* Properties setters */
+/* ####################################################################################### */
+
+    /**
+     * Set whether windows created after this call share context objects (OpenGL)
+     * with the already created ones.
+     * @param enabled Enabled or disabled context sharing.
+     */
+    void
+    setContextSharing(bool enabled);
+
+    /**
+     * Set how event loop paces iterations.
+     * @param pacing Pacing mode (EFramePacing::MonitorRate uses the fastest monitor of all windows).
+     * @param rate Iterations per second (used by EFramePacing::TargetRate only).
+     */
+    void
+    setFramePacing(EFramePacing pacing, double rate = 60.0);
+
+/* ####################################################################################### */
+public: /* Getters */
+/* ####################################################################################### */
+
+    /** Check whether platform (GLFW) was initialized, 'run' does nothing otherwise */
+    bool
+    initialized() const
+    {
+        return m_platform;
+    }
+
+    /** Get count of opened windows (including ones created by running loop and not started yet) */
+    std::size_t
+    windowsCount() const
+    {
+        return m_windows.size() + m_pending.size();
+    }
+
+    /** Get time the frame limiter inserted at the end of previous iteration (in seconds) */
+    double
+    frameWaitTime() const
+    {
+        return m_pacer.lastWait();
+    }
+
+/* ####################################################################################### */
+public: /* Methods */
+/* ####################################################################################### */
+
+    /**
+     * Create window owned by application. Window is destroyed after it was closed.
+     * Windows created while the loop runs join it at the start of the next iteration.
+     * @tparam T Window type.
+     * @param args Window constructor arguments.
+     * @return Created window.
+     */
+    template<typename T, typename ... Args>
+    T&
+    create(Args&& ... args);
+
+    /**
+     * Start event loop. Returns when all windows are closed.
+     */
+    void
+    run();
+
+    /**
+     * Close all windows. Windows created by running loop which didn't join it yet are destroyed.
+     */
+    void
+    quit();
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    void
+    pollEvents();
+
+    /**
+     * Create deferred windows and run loop setup, windows which can't be created are dropped.
+     * @param windows Windows to start, they share loop start time.
+     */
+    void
+    startWindows(std::vector<std::unique_ptr<Window>>& windows);
+
+    void
+    updateFramePacing();
+
+    std::vector<std::unique_ptr<Window>>
+    m_windows;
+
+    std::vector<std::unique_ptr<Window>>
+    m_pending {};           // created by running loop, started before next iteration
+
+    FramePacer
+    m_pacer {};
+
+    EFramePacing
+    m_pacing {EFramePacing::Unlimited};
+
+    double
+    m_targetRate {60.0};
+
+    bool
+    m_contextSharing {false};
+
+    bool
+    m_running {false};
+
+    bool
+    m_platform {false};     // GLFW was initialized for application
+};
+
+
+
+
+
+template<typename T, typename ... Args>
+T&
+Application::create(Args&& ... args)
+{
+    static_assert(std::is_base_of_v<Window, T>, "Application can create Window derived types only");
+
+    if (m_contextSharing && (!m_windows.empty() || !m_pending.empty()))
+    {
+        Window::setDefaultShareContext(!m_windows.empty() ? m_windows.front().get() : m_pending.front().get());
+    }
+
+    auto window = std::make_unique<T>(std::forward<Args>(args)...);
+    Window::setDefaultShareContext(nullptr);
+
+    T& result = *window;
+
+    // Running loop iterates windows, new one joins it later
+    if (m_running)
+    {
+        m_pending.push_back(std::move(window));
+    }
+    else
+    {
+        m_windows.push_back(std::move(window));
+    }
+
+    return result;
+}
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
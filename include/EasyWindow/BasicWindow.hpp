@@ -0,0 +1,173 @@
+#pragma once
+
+
+#include <EasyWindow/Window.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/**
+ * Window with handlers resolved at compile time (CRTP). Events are queued by GLFW callbacks
+ * and drained once per tick as with Window, then the dispatch function calls handlers
+ * declared by Derived through non virtual calls, which the compiler may inline into the
+ * dispatch function (not into GLFW callbacks, handlers run on tick, not inside the
+ * callbacks). Input handlers Derived doesn't declare are compiled out, except 'keyEvent'
+ * which falls back to Window one (Escape closes window).
+ *
+ * By default every GLFW callback is registered, input snapshot ('input', 'keyState'),
+ * cursor state, input coroutines and recording depend on queued events. With
+ * 'WindowConfig::maskUnhandledEvents' callbacks for input events Derived doesn't handle
+ * (besides keys) are not registered, which also stops tracking of their state. Loop
+ * handlers ('tickEvent', 'renderEvent', ...) are called once per frame and stay virtual.
+ *
+ *     class MyWindow : public BasicWindow<MyWindow>
+ *     {
+ *         friend BasicWindow<MyWindow>;
+ *
+ *     protected:
+ *         void keyEvent(EKey key, EState state, EModifier modifier) override;
+ *     };
+ *
+ * Handlers have to be accessible to BasicWindow (public or through friend declaration).
+ */
+template<typename Derived>
+class BasicWindow : public Window
+{
+
+/* ####################################################################################### */
+public: /* Constructors */
+/* ####################################################################################### */
+
+    explicit
+    BasicWindow(EOriginCorner originCorner)
+        : BasicWindow(config(originCorner))
+    {
+
+    }
+
+    explicit
+    BasicWindow(const WindowConfig& config)
+        : Window(config, config.maskUnhandledEvents ? eventMask() : AllEvents, &BasicWindow::dispatch)
+    {
+
+    }
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    template<typename R, typename ... Args>
+    static constexpr bool
+    declared(R (Derived::*)(Args...))
+    {
+        return true;
+    }
+
+    template<typename R, typename ... Args>
+    static constexpr bool
+    declared(R (Window::*)(Args...))
+    {
+        return false;
+    }
+
+    static WindowConfig
+    config(EOriginCorner originCorner)
+    {
+        WindowConfig result;
+        result.originCorner = originCorner;
+        return result;
+    }
+
+    static constexpr std::uint32_t
+    eventMask()
+    {
+        // Derived is complete only inside member functions bodies
+        constexpr bool HandlesMouseArea = declared(&Derived::mouseAreaEvent);
+        constexpr bool HandlesMouseMove = declared(&Derived::mouseMoveEvent);
+        constexpr bool HandlesButton = declared(&Derived::buttonEvent);
+        constexpr bool HandlesScroll = declared(&Derived::scrollEvent);
+
+        // Keys are always registered, Window handler closes window on Escape
+        return
+            eventBit(EEventType::Key) |
+            (HandlesMouseArea ? eventBit(EEventType::MouseArea) : 0) |
+            (HandlesMouseMove ? eventBit(EEventType::MouseMove) : 0) |
+            (HandlesButton ? eventBit(EEventType::Button) : 0) |
+            (HandlesScroll ? eventBit(EEventType::Scroll) : 0);
+    }
+
+    static void
+    dispatch(Window& window, const Event& event)
+    {
+        constexpr bool HandlesResize = declared(&Derived::resizeEvent);
+        constexpr bool HandlesKey = declared(&Derived::keyEvent);
+        constexpr bool HandlesMouseArea = declared(&Derived::mouseAreaEvent);
+        constexpr bool HandlesMouseMove = declared(&Derived::mouseMoveEvent);
+        constexpr bool HandlesButton = declared(&Derived::buttonEvent);
+        constexpr bool HandlesScroll = declared(&Derived::scrollEvent);
+
+        auto& self = static_cast<Derived&>(window);
+
+        switch (event.type)
+        {
+            case EEventType::Resize:
+            {
+                if constexpr (HandlesResize)
+                {
+                    self.Derived::resizeEvent();
+                }
+                break;
+            }
+            case EEventType::Key:
+            {
+                if constexpr (HandlesKey)
+                {
+                    self.Derived::keyEvent(event.key(), event.state(), event.modifier());
+                }
+                else
+                {
+                    self.Window::keyEvent(event.key(), event.state(), event.modifier());
+                }
+                break;
+            }
+            case EEventType::MouseArea:
+            {
+                if constexpr (HandlesMouseArea)
+                {
+                    self.Derived::mouseAreaEvent(event.code != 0);
+                }
+                break;
+            }
+            case EEventType::MouseMove:
+            {
+                if constexpr (HandlesMouseMove)
+                {
+                    self.Derived::mouseMoveEvent(self.eventPosition(event));
+                }
+                break;
+            }
+            case EEventType::Button:
+            {
+                if constexpr (HandlesButton)
+                {
+                    self.Derived::buttonEvent(event.button(), event.state(), event.modifier());
+                }
+                break;
+            }
+            case EEventType::Scroll:
+            {
+                if constexpr (HandlesScroll)
+                {
+                    self.Derived::scrollEvent(Vector<double>{event.x, event.y});
+                }
+                break;
+            }
+            default:
+            {
+                break;
+            }
+        }
+    }
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
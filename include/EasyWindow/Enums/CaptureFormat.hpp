@@ -0,0 +1,16 @@
+#pragma once
+
+
+#include <EasyWindow/Global.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+enum class ECaptureFormat : std::int64_t
+{
+    Raw             = 0,    // RGBA8 frames one after another in one file
+    Y4M             = 1,    // YUV4MPEG2 stream (I420, full range), playable by ffmpeg/mpv
+    Png             = 2     // file per frame (uncompressed deflate)
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
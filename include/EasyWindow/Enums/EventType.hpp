@@ -0,0 +1,22 @@
+#pragma once
+
+
+#include <EasyWindow/Global.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+enum class EEventType : std::uint32_t
+{
+    Resize      = 0,
+    Refresh     = 1,
+    Key         = 2,
+    MouseArea   = 3,
+    MouseMove   = 4,
+    Button      = 5,
+    Scroll      = 6,
+    Framebuffer = 7,
+    Scale       = 8
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
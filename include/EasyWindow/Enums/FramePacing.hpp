@@ -0,0 +1,16 @@
+#pragma once
+
+
+#include <EasyWindow/Global.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+enum class EFramePacing : std::int64_t
+{
+    Unlimited       = 0,    // no waiting between frames
+    TargetRate      = 1,    // wait to match user defined frame rate
+    MonitorRate     = 2     // wait to match refresh rate of the window monitor
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
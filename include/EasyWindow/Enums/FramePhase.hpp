@@ -0,0 +1,21 @@
+#pragma once
+
+
+#include <EasyWindow/Global.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+enum class EFramePhase : std::uint32_t
+{
+    Poll        = 0,    // pumping window system events
+    Dispatch    = 1,    // dispatching queued events to handlers
+    Tick        = 2,    // 'tickEvent'
+    Clear       = 3,    // 'clearEvent'
+    Render      = 4,    // 'renderEvent' without frame buffers swapping
+    Swap        = 5,    // 'swapFrameBuffers'
+    Wait        = 6,    // frame pacing
+    Count       = 7
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+
+#include <cstdint>
+#include <EasyWindow/Namespace.hpp>     // Global.hpp includes logger using this enum
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+enum class ELogLevel : std::int64_t
+{
+    Info            = 0,    // progress and diagnostics
+    Warning         = 1,    // unexpected state, library keeps going
+    Error           = 2,    // operation failed
+    None            = 3     // nothing is logged
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
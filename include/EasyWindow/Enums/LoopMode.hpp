@@ -0,0 +1,15 @@
+#pragma once
+
+
+#include <EasyWindow/Global.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+enum class ELoopMode : std::int64_t
+{
+    Continuous  = 0,    // poll events and render every iteration
+    OnDemand    = 1     // wait for events, render only if redraw was requested
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+
+#include <EasyWindow/Global.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+enum class EPresentMode : std::int64_t
+{
+    Immediate       = 0,    // present at once, may tear
+    Mailbox         = 1,    // wait for vertical blank, newer frame replaces queued one
+    Fifo            = 2,    // wait for vertical blank, frames are queued (always supported)
+    FifoRelaxed     = 3     // like Fifo, but late frame is presented at once
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
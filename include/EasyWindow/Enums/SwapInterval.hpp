@@ -0,0 +1,17 @@
+#pragma once
+
+
+#include <EasyWindow/Global.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+enum class ESwapInterval : std::int64_t
+{
+    Immediate       = 0,    // present at once, may tear
+    VSync           = 1,    // wait for vertical blank
+    Adaptive        = 2,    // vsync, late frames are presented at once (VSync if platform can't)
+    Auto            = 3     // switch between VSync and Immediate by measured frame times
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
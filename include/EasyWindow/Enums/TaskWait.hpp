@@ -0,0 +1,16 @@
+#pragma once
+
+
+#include <EasyWindow/Global.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+enum class ETaskWait : std::int64_t
+{
+    Frame           = 0,    // resume on the next frame
+    Time            = 1,    // resume when window time reaches given moment
+    Event           = 2     // resume on frame which received matching event
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
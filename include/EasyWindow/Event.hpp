@@ -0,0 +1,74 @@
+#pragma once
+
+
+#include <EasyWindow/Global.hpp>
+#include <EasyWindow/Enums/Keys.hpp>
+#include <EasyWindow/Enums/States.hpp>
+#include <EasyWindow/Enums/Buttons.hpp>
+#include <EasyWindow/Enums/Modifiers.hpp>
+#include <EasyWindow/Enums/EventType.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/**
+ * Compact window event record. Meaning of the fields depends on event type:
+ *  - Resize:       code = width, action = height
+ *  - Refresh:      no data
+ *  - Key:          code = key, action = state, mods = modifier
+ *  - MouseArea:    code = 1 if mouse entered window area, 0 if it left
+ *  - MouseMove:    x, y = cursor position (in screen coordinates, origin at top left)
+ *  - Button:       code = button, action = state, mods = modifier
+ *  - Scroll:       x, y = scroll offset
+ *  - Framebuffer:  code = width, action = height (in pixels)
+ *  - Scale:        x, y = window content scale
+ */
+struct Event
+{
+    EEventType
+    type {EEventType::Refresh};
+
+    std::int32_t
+    code {0};
+
+    std::int32_t
+    action {0};
+
+    std::int32_t
+    mods {0};
+
+    double
+    x {0.0};
+
+    double
+    y {0.0};
+
+    std::uint64_t
+    timestamp {0};   // steady clock time when window received event (in nanoseconds)
+
+    EKey
+    key() const
+    {
+        return static_cast<EKey>(code);
+    }
+
+    EButton
+    button() const
+    {
+        return static_cast<EButton>(code);
+    }
+
+    EState
+    state() const
+    {
+        return static_cast<EState>(action);
+    }
+
+    EModifier
+    modifier() const
+    {
+        return static_cast<EModifier>(mods);
+    }
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
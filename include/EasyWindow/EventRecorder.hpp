@@ -0,0 +1,108 @@
+#pragma once
+
+
+#include <string>
+#include <cstdio>
+#include <EasyWindow/Event.hpp>
+#include <EasyWindow/Global.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/**
+ * Header of events recording file, followed by raw Event records
+ * with timestamps relative to recording start.
+ */
+struct EventRecordingHeader
+{
+    char
+    magic[8] {'E','Z','W','R','E','C','0','1'};
+
+    std::uint32_t
+    version {1};
+
+    std::uint32_t
+    eventSize {sizeof(Event)};
+};
+
+/* --------------------------------------------------------------------------------------- */
+
+/**
+ * Streams window events to compact binary file. Attach it to window with
+ * 'Window::setEventRecorder', every event received from window system is
+ * written on the thread pumping events (injected and replayed events are not).
+ */
+class EventRecorder
+{
+
+/* ####################################################################################### */
+public: /* Constructors */
+/* ####################################################################################### */
+
+    ~EventRecorder();
+
+    EventRecorder() = default;
+
+    EventRecorder(const EventRecorder&) = delete;
+
+    EventRecorder&
+    operator=(const EventRecorder&) = delete;
+
+/* ####################################################################################### */
+public: /* Methods */
+/* ####################################################################################### */
+
+    /**
+     * Start recording to file (previous recording is finished).
+     * @param path File path.
+     * @return True if file was opened.
+     */
+    bool
+    open(const std::string& path);
+
+    /**
+     * Finish recording and flush file.
+     */
+    void
+    close();
+
+    /**
+     * Write event.
+     * @param event Event to write, its timestamp is rebased to recording start.
+     */
+    void
+    record(Event event);
+
+/* ####################################################################################### */
+public: /* Getters */
+/* ####################################################################################### */
+
+    /** Check whether recording is in progress */
+    bool
+    isOpen() const
+    {
+        return m_file != nullptr;
+    }
+
+    /** Get count of recorded events */
+    std::uint64_t
+    recordedCount() const
+    {
+        return m_count;
+    }
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    std::FILE*
+    m_file {nullptr};
+
+    std::uint64_t
+    m_start {0};
+
+    std::uint64_t
+    m_count {0};
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
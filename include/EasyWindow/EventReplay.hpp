@@ -0,0 +1,114 @@
+#pragma once
+
+
+#include <string>
+#include <EasyWindow/Event.hpp>
+#include <EasyWindow/Global.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/**
+ * Plays back events recorded by EventRecorder. File is memory mapped, events are
+ * handed out directly from the mapping. Attach it to window with 'Window::setEventReplay',
+ * window appends due events to each tick batch. Events become due by window time,
+ * so replay runs in real time with 'run' and as fast as possible with 'runFrames'.
+ */
+class EventReplay
+{
+
+/* ####################################################################################### */
+public: /* Constructors */
+/* ####################################################################################### */
+
+    ~EventReplay();
+
+    EventReplay() = default;
+
+    EventReplay(const EventReplay&) = delete;
+
+    EventReplay&
+    operator=(const EventReplay&) = delete;
+
+/* ####################################################################################### */
+public: /* Methods */
+/* ####################################################################################### */
+
+    /**
+     * Map recording file (previous one is unmapped).
+     * @param path File path.
+     * @return True if file is valid recording.
+     */
+    bool
+    open(const std::string& path);
+
+    /**
+     * Unmap recording file.
+     */
+    void
+    close();
+
+    /**
+     * Start playback from the first event.
+     */
+    void
+    restart();
+
+    /**
+     * Take events due at given time. Time of the first call is playback start.
+     * @param time Current time (in seconds).
+     * @param maxCount Max events count to take.
+     * @return Due events.
+     */
+    Span<Event>
+    advance(double time, std::size_t maxCount);
+
+/* ####################################################################################### */
+public: /* Getters */
+/* ####################################################################################### */
+
+    /** Check whether recording is mapped */
+    bool
+    isOpen() const
+    {
+        return m_events != nullptr;
+    }
+
+    /** Check whether all events were played */
+    bool
+    finished() const
+    {
+        return m_cursor >= m_count;
+    }
+
+    /** Get all recorded events */
+    Span<Event>
+    events() const
+    {
+        return {m_events, m_count};
+    }
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    void*
+    m_mapping {nullptr};
+
+    std::size_t
+    m_mappingSize {0};
+
+    const Event*
+    m_events {nullptr};
+
+    std::size_t
+    m_count {0};
+
+    std::size_t
+    m_cursor {0};
+
+    double
+    m_start {-1.0};
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
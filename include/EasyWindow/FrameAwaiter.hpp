@@ -0,0 +1,82 @@
+#pragma once
+
+
+#include <EasyWindow/Event.hpp>
+#include <EasyWindow/Window.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/**
+ * Awaitable returned by 'Window::nextFrame', 'Window::seconds', 'Window::nextKey' and
+ * 'Window::nextButton'. Suspended coroutine is kept by window and resumed on the thread
+ * running window frames, after tick events are dispatched and right before 'tickEvent'.
+ * 'co_await' yields event which resumed it (default constructed for frame and time waits).
+ * Awaiting requires C++20 coroutines (see FrameTask.hpp), the type itself is C++17.
+ */
+class FrameAwaiter
+{
+
+/* ####################################################################################### */
+public: /* Constructors */
+/* ####################################################################################### */
+
+    FrameAwaiter(Window& window, const TaskWait& wait)
+        : m_window(window)
+        , m_wait(wait)
+    {
+
+    }
+
+/* ####################################################################################### */
+public: /* Awaitable interface */
+/* ####################################################################################### */
+
+    bool
+    await_ready() const noexcept
+    {
+        return false;
+    }
+
+    template<typename Handle>
+    void
+    await_suspend(Handle handle)
+    {
+        m_window.suspendTask(m_wait, {handle.address(), &resume<Handle>, &destroy<Handle>, &m_event});
+    }
+
+    Event
+    await_resume() const noexcept
+    {
+        return m_event;
+    }
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    template<typename Handle>
+    static void
+    resume(void* address)
+    {
+        Handle::from_address(address).resume();
+    }
+
+    template<typename Handle>
+    static void
+    destroy(void* address)
+    {
+        Handle::from_address(address).destroy();
+    }
+
+    Window&
+    m_window;
+
+    TaskWait
+    m_wait;
+
+    Event
+    m_event {};
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
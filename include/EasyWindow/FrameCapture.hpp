@@ -0,0 +1,250 @@
+#pragma once
+
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <EasyWindow/Global.hpp>
+#include <EasyWindow/FrameWriter.hpp>
+#include <EasyWindow/VulkanSwapchain.hpp>
+#include <EasyWindow/Enums/CaptureFormat.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+struct CaptureConfig
+{
+    std::string
+    path {"capture.y4m"};           // output file, path prefix of frame files for Png
+
+    ECaptureFormat
+    format {ECaptureFormat::Y4M};
+
+    std::uint32_t
+    readbackSlots {3};              // frames GPU or writer may hold, Vulkan adds swapchain frames in flight
+
+    double
+    frameRate {60.0};               // frame rate written to Y4M header
+};
+
+struct CaptureStats
+{
+    std::uint64_t
+    captured {0};       // frames read back and handed to writer
+
+    std::uint64_t
+    written {0};        // frames written to disk
+
+    std::uint64_t
+    dropped {0};        // frames skipped because all readback slots or writer queue were full
+
+    std::uint64_t
+    failed {0};         // frames writer couldn't write
+};
+
+/**
+ * Asynchronous back buffer capture. Each captured frame is copied by GPU into the next
+ * slot of a ring of mapped readback buffers, once the copy is done the slot memory is
+ * handed to 'FrameWriter' as it is and the slot is reused after the writer is done with
+ * it. Render thread never waits for GPU nor disk: if the next slot is not free the frame
+ * is dropped.
+ *
+ * OpenGL: persistently mapped pixel pack buffers, 'readBack' is called by
+ * 'Window::swapFrameBuffers' and copies are collected by fences in following frames.
+ *
+ * Vulkan: host visible buffers, 'record' is called by user after rendering into the
+ * swapchain image. Copy is collected when its swapchain frame slot is acquired again.
+ */
+class FrameCapture
+{
+
+/* ####################################################################################### */
+public: /* Constructors */
+/* ####################################################################################### */
+
+    /** Completes pending readbacks, writes queued frames and frees readback memory */
+    ~FrameCapture();
+
+#ifdef EZWINDOW_OPENGL
+    /**
+     * Starts writer. Context has to be current on calling thread.
+     * @param config Output and readback params.
+     */
+    explicit
+    FrameCapture(const CaptureConfig& config);
+#endif
+
+#ifdef EZWINDOW_VULKAN
+    /**
+     * Starts writer. Swapchain images have to be created with VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+     * swapchain has to outlive capture.
+     * @param config Output and readback params.
+     * @param swapchain Captured swapchain.
+     */
+    FrameCapture(const CaptureConfig& config, const VulkanSwapchain& swapchain);
+#endif
+
+    FrameCapture(const FrameCapture&) = delete;
+
+    FrameCapture&
+    operator=(const FrameCapture&) = delete;
+
+/* ####################################################################################### */
+public: /* Methods */
+/* ####################################################################################### */
+
+#ifdef EZWINDOW_OPENGL
+    /**
+     * Hand finished readbacks to writer and read back buffer of default framebuffer into
+     * the next free slot. Call before swapping buffers.
+     * @param width Framebuffer width.
+     * @param height Framebuffer height.
+     */
+    void
+    readBack(std::uint32_t width, std::uint32_t height);
+#endif
+
+#ifdef EZWINDOW_VULKAN
+    /**
+     * Hand readbacks finished by frame slot fence to writer and record copy of swapchain
+     * image into the next free slot. Image has to be in VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+     * (after render pass), it is left in the same layout. Command buffer has to be
+     * submitted with frame fence.
+     * @param commands Command buffer of frame.
+     * @param frame Frame returned by 'VulkanSwapchain::acquire'.
+     */
+    void
+    record(VkCommandBuffer commands, const VulkanFrame& frame);
+#endif
+
+/* ####################################################################################### */
+public: /* Getters */
+/* ####################################################################################### */
+
+    /** Get capture config */
+    const CaptureConfig&
+    config() const
+    {
+        return m_config;
+    }
+
+    /** Get frames counters */
+    CaptureStats
+    stats() const;
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    struct Slot
+    {
+        std::atomic<bool>
+        busy {false};           // writer reads slot memory
+
+        bool
+        pending {false};        // GPU copy issued, not handed to writer yet
+
+        std::uint64_t
+        index {0};
+
+        std::uint32_t
+        width {0};
+
+        std::uint32_t
+        height {0};
+
+        std::uint64_t
+        size {0};
+
+        unsigned char*
+        mapped {nullptr};
+
+        bool
+        bgra {false};
+
+#ifdef EZWINDOW_OPENGL
+        std::uint32_t
+        buffer {0};
+
+        void*
+        fence {nullptr};
+#endif
+
+#ifdef EZWINDOW_VULKAN
+        VkBuffer
+        buffer {VK_NULL_HANDLE};
+
+        VkDeviceMemory
+        memory {VK_NULL_HANDLE};
+
+        std::uint32_t
+        frameSlot {0};          // swapchain frame slot whose fence completes the copy
+#endif
+    };
+
+    /** Hand slot memory to writer, drop frame if writer queue is full */
+    void
+    submit(Slot& slot);
+
+    /** Make sure slot memory holds size bytes, slot must not be used by GPU nor writer */
+    bool
+    reserve(Slot& slot, std::uint64_t size);
+
+    void
+    release(Slot& slot);
+
+#ifdef EZWINDOW_OPENGL
+    /** Submit finished readbacks in order, wait for all of them if 'all' */
+    void
+    collect(bool all);
+#endif
+
+#ifdef EZWINDOW_VULKAN
+    /** Submit readbacks in order up to the last one completed by frame slot fence */
+    void
+    collect(std::uint32_t frameSlot);
+#endif
+
+    CaptureConfig
+    m_config {};
+
+    std::unique_ptr<FrameWriter>
+    m_writer {};
+
+    std::unique_ptr<Slot[]>
+    m_slots {};
+
+    std::uint32_t
+    m_slotsCount {0};
+
+    std::uint32_t
+    m_head {0};             // oldest pending slot
+
+    std::uint32_t
+    m_next {0};             // slot of next readback
+
+    std::uint64_t
+    m_frame {0};
+
+    std::uint64_t
+    m_captured {0};
+
+    std::uint64_t
+    m_dropped {0};
+
+    bool
+    m_flipped {false};      // rows are read bottom to top
+
+#ifdef EZWINDOW_VULKAN
+    const VulkanSwapchain*
+    m_swapchain {nullptr};
+
+    VkPhysicalDeviceMemoryProperties
+    m_memory {};
+
+    bool
+    m_unsupported {false};  // swapchain format is not 8 bit RGBA or BGRA, warned once
+#endif
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,181 @@
+#pragma once
+
+
+#include <array>
+#include <EasyWindow/Global.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+struct FrameTimeSummary
+{
+    std::uint64_t
+    min {0};            // nanoseconds
+
+    std::uint64_t
+    max {0};            // nanoseconds
+
+    double
+    average {0.0};      // nanoseconds
+
+    double
+    smoothed {0.0};     // exponential moving average (in nanoseconds)
+};
+
+/**
+ * Integer nanosecond frame clock: time since loop start, tick delta, frame number and
+ * history of recent frame times. Min, max and average over history are updated in
+ * constant time per tick (monotonic queues and running sum), history is stored twice
+ * in a row so the recent frames are always one contiguous range.
+ */
+class FrameClock
+{
+
+/* ####################################################################################### */
+public: /* Constants */
+/* ####################################################################################### */
+
+    /** Frame times kept in history */
+    static constexpr std::size_t
+    HistorySize = 256;
+
+/* ####################################################################################### */
+public: /* Methods */
+/* ####################################################################################### */
+
+    /**
+     * Restart time from zero, frame number and history are kept.
+     * @param now Steady clock time (in nanoseconds).
+     */
+    void
+    reset(std::uint64_t now);
+
+    /**
+     * Start next frame at given moment.
+     * @param now Steady clock time (in nanoseconds).
+     */
+    void
+    tick(std::uint64_t now);
+
+    /**
+     * Start next frame by advancing time by fixed step.
+     * @param delta Step (in nanoseconds).
+     */
+    void
+    step(std::uint64_t delta);
+
+    /**
+     * Set weight of the latest frame in exponential moving average.
+     * @param factor Weight in range (0,1].
+     */
+    void
+    setSmoothing(double factor);
+
+/* ####################################################################################### */
+public: /* Getters */
+/* ####################################################################################### */
+
+    /** Get time of current frame since reset (in nanoseconds) */
+    std::uint64_t
+    time() const
+    {
+        return m_time;
+    }
+
+    /** Get time between previous and current frames (in nanoseconds) */
+    std::uint64_t
+    delta() const
+    {
+        return m_delta;
+    }
+
+    /** Get current frame number, increases by one each tick and never resets */
+    std::uint64_t
+    frame() const
+    {
+        return m_frame;
+    }
+
+    /** Get recent frame times from oldest to newest (in nanoseconds), valid until next tick */
+    Span<std::uint64_t>
+    history() const
+    {
+        if (m_count == 0)
+        {
+            return {};
+        }
+
+        const std::size_t end = (m_written - 1) % HistorySize + 1 + HistorySize;
+        return {m_history.data() + end - m_count, m_count};
+    }
+
+    /** Get min, max and average of history and smoothed frame time */
+    FrameTimeSummary
+    summary() const;
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    struct Extreme
+    {
+        std::uint64_t frame;
+        std::uint64_t value;
+    };
+
+    /** Window extreme in constant amortized time: values which can't become extreme are dropped */
+    struct ExtremeQueue
+    {
+        std::array<Extreme, HistorySize> items {};
+        std::size_t head {0};
+        std::size_t count {0};
+
+        template<typename Compare>
+        void
+        push(std::uint64_t frame, std::uint64_t value, Compare dominates);
+    };
+
+    void
+    record(std::uint64_t delta);
+
+    std::uint64_t
+    m_origin {0};
+
+    std::uint64_t
+    m_time {0};
+
+    std::uint64_t
+    m_delta {0};
+
+    std::uint64_t
+    m_frame {0};
+
+    std::array<std::uint64_t, HistorySize * 2>
+    m_history {};
+
+    std::uint64_t
+    m_written {0};      // frame times written since construction
+
+    std::size_t
+    m_count {0};        // frame times in history
+
+    std::uint64_t
+    m_sum {0};
+
+    ExtremeQueue
+    m_min {};
+
+    ExtremeQueue
+    m_max {};
+
+    double
+    m_smoothed {0.0};
+
+    double
+    m_smoothing {0.1};
+
+    bool
+    m_ticked {false};   // first tick after reset has no previous frame
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+
+
+#include <chrono>
+#include <EasyWindow/Global.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/**
+ * Keeps frames at a fixed rate. Waits with a hybrid strategy: sleeps most of the
+ * remaining time and spins the last part, so the deadline is hit precisely
+ * without burning a whole core.
+ */
+class FramePacer
+{
+
+/* ####################################################################################### */
+public: /* Aliases */
+/* ####################################################################################### */
+
+    using Clock = std::chrono::steady_clock;
+
+/* ####################################################################################### */
+public: /* Methods */
+/* ####################################################################################### */
+
+    /**
+     * Set frames per second to pace to.
+     * @param rate Frames per second. Zero or negative value disables pacing.
+     */
+    void
+    setTargetRate(double rate);
+
+    /**
+     * Start new frames sequence from current moment.
+     */
+    void
+    reset();
+
+    /**
+     * Block until next frame deadline.
+     * @return Time spent in waiting (in seconds).
+     */
+    double
+    wait();
+
+/* ####################################################################################### */
+public: /* Getters */
+/* ####################################################################################### */
+
+    /** Get frames per second pacer is waiting for (0 if disabled) */
+    double
+    targetRate() const
+    {
+        return m_rate;
+    }
+
+    /** Get time inserted by the last wait (in seconds) */
+    double
+    lastWait() const
+    {
+        return m_lastWait;
+    }
+
+    /** Get time before deadline at which pacer switches from sleeping to spinning (in seconds) */
+    double
+    spinThreshold() const
+    {
+        return std::chrono::duration<double>(m_spinThreshold).count();
+    }
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    Clock::time_point
+    m_deadline {};
+
+    Clock::duration
+    m_period {0};
+
+    Clock::duration
+    m_spinThreshold {std::chrono::microseconds(1000)};
+
+    double
+    m_rate {0.0};
+
+    double
+    m_lastWait {0.0};
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,212 @@
+#pragma once
+
+
+#include <array>
+#include <string>
+#include <EasyWindow/Global.hpp>
+#include <EasyWindow/Enums/FramePhase.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/**
+ * Fixed size log-linear histogram of durations (in nanoseconds). Each power of two
+ * range is split into 16 linear buckets, so relative error is about 6%.
+ */
+class Histogram
+{
+
+/* ####################################################################################### */
+public: /* Constants */
+/* ####################################################################################### */
+
+    static constexpr std::uint32_t
+    SubBucketBits = 4;
+
+    static constexpr std::uint32_t
+    SubBuckets = 1u << SubBucketBits;
+
+    static constexpr std::uint32_t
+    MaxExponent = 40;   // values above ~18 minutes are clamped
+
+    static constexpr std::uint32_t
+    BucketsCount = (MaxExponent - SubBucketBits + 2) * SubBuckets;
+
+/* ####################################################################################### */
+public: /* Methods */
+/* ####################################################################################### */
+
+    /**
+     * Add value to histogram.
+     * @param value Duration (in nanoseconds).
+     */
+    void
+    record(std::uint64_t value)
+    {
+        m_buckets[bucket(value)] += 1;
+        m_count += 1;
+        m_sum += value;
+        m_max = value > m_max ? value : m_max;
+    }
+
+    /**
+     * Gets value below which given fraction of recorded values falls.
+     * @param quantile Fraction in range [0,1].
+     * @return Upper bound of bucket containing quantile (in nanoseconds).
+     */
+    std::uint64_t
+    percentile(double quantile) const;
+
+    /**
+     * Remove all recorded values.
+     */
+    void
+    reset();
+
+/* ####################################################################################### */
+public: /* Getters */
+/* ####################################################################################### */
+
+    /** Get recorded values count */
+    std::uint64_t
+    count() const
+    {
+        return m_count;
+    }
+
+    /** Get max recorded value (in nanoseconds) */
+    std::uint64_t
+    max() const
+    {
+        return m_max;
+    }
+
+    /** Get mean of recorded values (in nanoseconds) */
+    double
+    mean() const
+    {
+        return m_count ? double(m_sum) / double(m_count) : 0.0;
+    }
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    static std::uint32_t
+    bucket(std::uint64_t value);
+
+    static std::uint64_t
+    bucketUpperBound(std::uint32_t index);
+
+    std::array<std::uint32_t, BucketsCount>
+    m_buckets {};
+
+    std::uint64_t
+    m_count {0};
+
+    std::uint64_t
+    m_sum {0};
+
+    std::uint64_t
+    m_max {0};
+};
+
+/* --------------------------------------------------------------------------------------- */
+
+struct PhaseSummary
+{
+    std::uint64_t count {0};
+    std::uint64_t p50 {0};     // nanoseconds
+    std::uint64_t p95 {0};     // nanoseconds
+    std::uint64_t p99 {0};     // nanoseconds
+    std::uint64_t max {0};     // nanoseconds
+    double mean {0.0};         // nanoseconds
+};
+
+/* --------------------------------------------------------------------------------------- */
+
+/**
+ * Durations of each event loop phase.
+ */
+class FrameStats
+{
+
+/* ####################################################################################### */
+public: /* Methods */
+/* ####################################################################################### */
+
+    /**
+     * Add phase duration.
+     * @param phase Loop phase.
+     * @param duration Phase duration (in nanoseconds).
+     */
+    void
+    record(EFramePhase phase, std::uint64_t duration)
+    {
+        m_phases[std::size_t(phase)].record(duration);
+    }
+
+    /**
+     * Gets histogram of phase.
+     * @param phase Loop phase.
+     * @return Phase histogram.
+     */
+    const Histogram&
+    histogram(EFramePhase phase) const
+    {
+        return m_phases[std::size_t(phase)];
+    }
+
+    /**
+     * Gets phase percentiles.
+     * @param phase Loop phase.
+     * @return Phase summary.
+     */
+    PhaseSummary
+    summary(EFramePhase phase) const;
+
+    /**
+     * Remove all recorded durations.
+     */
+    void
+    reset();
+
+    /**
+     * Gets all phases summaries as CSV table (one row per phase).
+     * @return CSV text.
+     */
+    std::string
+    toCsv() const;
+
+    /**
+     * Gets all phases summaries as JSON object (one member per phase).
+     * @return JSON text.
+     */
+    std::string
+    toJson() const;
+
+    /**
+     * Writes summaries to file. Format is chosen by extension: CSV for '.csv', JSON otherwise.
+     * @param path File path.
+     * @return True if file was written.
+     */
+    bool
+    write(const std::string& path) const;
+
+    /**
+     * Gets phase name.
+     * @param phase Loop phase.
+     * @return Phase name.
+     */
+    static const char*
+    phaseName(EFramePhase phase);
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    std::array<Histogram, std::size_t(EFramePhase::Count)>
+    m_phases {};
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
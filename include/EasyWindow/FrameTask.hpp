@@ -0,0 +1,72 @@
+#pragma once
+
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#define EZWINDOW_COROUTINES
+
+#include <coroutine>
+#include <exception>
+#include <EasyWindow/FrameAwaiter.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/**
+ * Fire and forget coroutine driven by window frames. It runs immediately until the first
+ * 'co_await' and is resumed by window when awaited condition is met:
+ *
+ *     FrameTask load(Window& window)
+ *     {
+ *         for (auto& chunk : chunks)
+ *         {
+ *             upload(chunk);
+ *             co_await window.nextFrame();
+ *         }
+ *
+ *         co_await window.seconds(0.5);
+ *         co_await window.nextKey(EKey::Escape);
+ *     }
+ *
+ * Coroutine frame is freed when it finishes, or by window destructor if it is still waiting.
+ * Exception escaping the coroutine terminates the program.
+ */
+struct FrameTask
+{
+    struct promise_type
+    {
+        FrameTask
+        get_return_object() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never
+        initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never
+        final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void
+        return_void() noexcept
+        {
+
+        }
+
+        void
+        unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+EZWINDOW_NAMESPACE_END
+
+#endif
\ No newline at end of file
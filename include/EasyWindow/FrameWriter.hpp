@@ -0,0 +1,188 @@
+#pragma once
+
+
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <condition_variable>
+#include <EasyWindow/Global.hpp>
+#include <EasyWindow/SpscRing.hpp>
+#include <EasyWindow/Enums/CaptureFormat.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/**
+ * Captured frame handed to writer. Pixels are read in place (mapped readback memory),
+ * writer clears 'busy' once it doesn't need them anymore.
+ */
+struct CaptureFrame
+{
+    const unsigned char*
+    pixels {nullptr};       // tightly packed 8 bit 4 channel rows
+
+    std::uint32_t
+    width {0};
+
+    std::uint32_t
+    height {0};
+
+    std::uint64_t
+    index {0};              // captured frame number
+
+    bool
+    flipped {false};        // rows are stored bottom to top (OpenGL)
+
+    bool
+    bgra {false};           // channels are stored as BGRA
+
+    std::atomic<bool>*
+    busy {nullptr};
+};
+
+/**
+ * Background thread writing captured frames as raw RGBA, Y4M or PNG sequence. Submitting
+ * never blocks: when writer falls behind its queue fills up and frames are rejected.
+ */
+class FrameWriter
+{
+
+/* ####################################################################################### */
+public: /* Constants */
+/* ####################################################################################### */
+
+    /** Frames waiting for writer */
+    static constexpr std::size_t
+    QueueCapacity = 16;
+
+/* ####################################################################################### */
+public: /* Constructors */
+/* ####################################################################################### */
+
+    /** Writes queued frames and stops writer thread */
+    ~FrameWriter();
+
+    /**
+     * Starts writer thread.
+     * @param path Output file (Raw, Y4M) or path prefix of frame files (Png, '<path>_000042.png').
+     * @param format Output format.
+     * @param frameRate Frame rate written to Y4M header.
+     */
+    FrameWriter(const std::string& path, ECaptureFormat format, double frameRate);
+
+    FrameWriter(const FrameWriter&) = delete;
+
+    FrameWriter&
+    operator=(const FrameWriter&) = delete;
+
+/* ####################################################################################### */
+public: /* Methods */
+/* ####################################################################################### */
+
+    /**
+     * Queue frame (never blocks, single producer thread).
+     * @param frame Captured frame, its 'busy' flag is cleared when it is written.
+     * @return False if queue is full, frame is not taken.
+     */
+    bool
+    submit(const CaptureFrame& frame);
+
+    /**
+     * Convert RGBA (or BGRA) image to I420 planes, BT.601 full range. Odd last row and
+     * column are averaged with themselves. Uses SSE2 where available.
+     * @param frame Source image.
+     * @param y Luma plane (width * height).
+     * @param u Cb plane ((width + 1) / 2 * (height + 1) / 2).
+     * @param v Cr plane ((width + 1) / 2 * (height + 1) / 2).
+     */
+    static void
+    convertI420(const CaptureFrame& frame, unsigned char* y, unsigned char* u, unsigned char* v);
+
+/* ####################################################################################### */
+public: /* Getters */
+/* ####################################################################################### */
+
+    /** Get written frames count */
+    std::uint64_t
+    written() const
+    {
+        return m_written.load(std::memory_order_relaxed);
+    }
+
+    /** Get frames which couldn't be written (I/O error, size change in stream) */
+    std::uint64_t
+    failed() const
+    {
+        return m_failed.load(std::memory_order_relaxed);
+    }
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    void
+    writerLoop();
+
+    bool
+    write(const CaptureFrame& frame);
+
+    bool
+    writeRaw(const CaptureFrame& frame);
+
+    bool
+    writeY4M(const CaptureFrame& frame);
+
+    bool
+    writePng(const CaptureFrame& frame);
+
+    /** Copy row as RGBA, top to bottom */
+    void
+    copyRow(const CaptureFrame& frame, std::uint32_t row, unsigned char* destination) const;
+
+    std::string
+    m_path;
+
+    ECaptureFormat
+    m_format;
+
+    double
+    m_frameRate;
+
+    std::FILE*
+    m_file {nullptr};       // Raw and Y4M stream
+
+    std::uint32_t
+    m_width {0};            // stream frame size, set by the first frame
+
+    std::uint32_t
+    m_height {0};
+
+    std::vector<unsigned char>
+    m_buffer {};            // conversion scratch, reused between frames
+
+    SpscRing<CaptureFrame, QueueCapacity>
+    m_queue {};
+
+    std::atomic<std::uint64_t>
+    m_written {0};
+
+    std::atomic<std::uint64_t>
+    m_failed {0};
+
+    std::mutex
+    m_wakeMutex;
+
+    std::condition_variable
+    m_wake;
+
+    std::atomic<bool>
+    m_stop {false};
+
+    std::thread
+    m_thread;
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
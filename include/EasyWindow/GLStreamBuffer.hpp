@@ -0,0 +1,183 @@
+#pragma once
+
+
+#ifdef EZWINDOW_OPENGL
+
+#include <vector>
+#include <EasyWindow/Global.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+struct StreamAllocation
+{
+    void*
+    data {nullptr};         // mapped memory to write into, nullptr if frame region is full
+
+    std::uint64_t
+    offset {0};             // offset in buffer, use with 'glBindBufferRange', vertex array offsets, ...
+
+    std::uint64_t
+    size {0};
+};
+
+struct StreamStats
+{
+    std::uint64_t
+    allocations {0};        // successful allocations since last reset
+
+    std::uint64_t
+    allocatedBytes {0};     // bytes handed out since last reset (including alignment padding)
+
+    std::uint64_t
+    peakFrameBytes {0};     // max bytes used by one frame
+
+    std::uint64_t
+    failedAllocations {0};  // allocations which didn't fit into frame region
+
+    std::uint64_t
+    stalls {0};             // frames which had to wait for GPU to release their region
+
+    double
+    stallTime {0.0};        // time spent waiting for GPU (in seconds)
+};
+
+/**
+ * Streaming upload ring in one persistently and coherently mapped buffer. Buffer is split
+ * into a region per frame in flight, each frame allocates linearly from its own region:
+ *
+ *     StreamAllocation vertices = stream.upload(data, size);
+ *     glVertexArrayVertexBuffer(vao, 0, stream.buffer(), GLintptr(vertices.offset), stride);
+ *
+ * Uploads are plain memcpy, buffer is never respecified nor remapped. 'endFrame' (called by
+ * 'Window::swapFrameBuffers') fences commands of the frame and moves to the next region,
+ * waiting only if GPU still reads it (frames in flight exceeded). Needs OpenGL 4.4+ or
+ * ARB_buffer_storage, must be used on the thread owning the context.
+ */
+class GLStreamBuffer
+{
+
+/* ####################################################################################### */
+public: /* Constructors */
+/* ####################################################################################### */
+
+    ~GLStreamBuffer();
+
+    /**
+     * Creates and maps buffer of frameSize * framesCount bytes.
+     * @param frameSize Bytes each frame may allocate.
+     * @param framesCount Frames in flight (regions count).
+     */
+    explicit
+    GLStreamBuffer(std::uint64_t frameSize, std::uint32_t framesCount = 3);
+
+    GLStreamBuffer(const GLStreamBuffer&) = delete;
+
+    GLStreamBuffer&
+    operator=(const GLStreamBuffer&) = delete;
+
+/* ####################################################################################### */
+public: /* Methods */
+/* ####################################################################################### */
+
+    /**
+     * Allocate memory in current frame region.
+     * @param size Bytes count.
+     * @param alignment Offset alignment (power of two, others are rounded up to one, 256 fits
+     * uniform buffer offsets everywhere).
+     * @return Allocation, with nullptr data if region has no space left.
+     */
+    StreamAllocation
+    allocate(std::uint64_t size, std::uint64_t alignment = 256);
+
+    /**
+     * Allocate memory in current frame region and copy data into it.
+     * @param data Data to copy.
+     * @param size Bytes count.
+     * @param alignment Offset alignment (power of two).
+     * @return Allocation, with nullptr data if region has no space left.
+     */
+    StreamAllocation
+    upload(const void* data, std::uint64_t size, std::uint64_t alignment = 256);
+
+    /**
+     * Fence commands issued by current frame and move to the next region,
+     * waiting for GPU to finish with it if needed.
+     */
+    void
+    endFrame();
+
+    /**
+     * Clear allocation stats.
+     */
+    void
+    resetStats();
+
+/* ####################################################################################### */
+public: /* Getters */
+/* ####################################################################################### */
+
+    /** Get OpenGL buffer name */
+    std::uint32_t
+    buffer() const
+    {
+        return m_buffer;
+    }
+
+    /** Get bytes each frame may allocate */
+    std::uint64_t
+    frameSize() const
+    {
+        return m_frameSize;
+    }
+
+    /** Get frames in flight count */
+    std::uint32_t
+    framesCount() const
+    {
+        return std::uint32_t(m_fences.size());
+    }
+
+    /** Get bytes allocated by current frame */
+    std::uint64_t
+    frameBytes() const
+    {
+        return m_head;
+    }
+
+    /** Get allocation stats since last reset */
+    const StreamStats&
+    stats() const
+    {
+        return m_stats;
+    }
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    std::uint32_t
+    m_buffer {0};
+
+    unsigned char*
+    m_mapped {nullptr};
+
+    std::uint64_t
+    m_frameSize {0};
+
+    std::vector<void*>
+    m_fences {};        // GLsync per region, null if region was not used yet
+
+    std::uint32_t
+    m_region {0};
+
+    std::uint64_t
+    m_head {0};         // bytes used in current region
+
+    StreamStats
+    m_stats {};
+};
+
+EZWINDOW_NAMESPACE_END
+
+#endif
\ No newline at end of file
@@ -0,0 +1,129 @@
+#pragma once
+
+
+#ifdef EZWINDOW_OPENGL
+
+#include <mutex>
+#include <vector>
+#include <functional>
+#include <EasyWindow/Global.hpp>
+
+
+class GLFWwindow;
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/**
+ * Hidden context sharing objects with window context, to create and fill textures,
+ * buffers, ... on a worker thread while window renders:
+ *
+ *     context.makeCurrent();
+ *     glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+ *     glTextureStorage2D(texture, ...);
+ *     glTextureSubImage2D(texture, ...);
+ *     context.finish([&, texture]{ m_textures.push_back(texture); });
+ *
+ * 'finish' fences the uploads, the callback is called on render thread (before 'tickEvent')
+ * once GPU completed them, so render thread never waits for the uploads. Until then
+ * the objects must not be used by render thread. Created by 'Window::createUploadContexts'.
+ */
+class GLUploadContext
+{
+
+/* ####################################################################################### */
+public: /* Constructors */
+/* ####################################################################################### */
+
+    /**
+     * Destroys context (main thread only). Context must not be current on any thread,
+     * context sharing objects with it has to be current on calling thread.
+     */
+    ~GLUploadContext();
+
+    /**
+     * Creates hidden context (main thread only).
+     * @param share Window whose context shares objects with created one.
+     */
+    explicit
+    GLUploadContext(GLFWwindow* share);
+
+    GLUploadContext(const GLUploadContext&) = delete;
+
+    GLUploadContext&
+    operator=(const GLUploadContext&) = delete;
+
+/* ####################################################################################### */
+public: /* Methods */
+/* ####################################################################################### */
+
+    /**
+     * Make context current on calling thread (one thread at a time).
+     */
+    void
+    makeCurrent();
+
+    /**
+     * Detach context from calling thread.
+     */
+    void
+    release();
+
+    /**
+     * Fence commands issued so far and flush them. Must be called on thread context is current on.
+     * @param ready Function called on render thread once GPU completed the commands.
+     */
+    void
+    finish(std::function<void()> ready);
+
+    /**
+     * Call ready functions of finished uploads, never waits for GPU. Called by window
+     * on render thread each frame.
+     * @return Finished uploads count.
+     */
+    std::size_t
+    collect();
+
+/* ####################################################################################### */
+public: /* Getters */
+/* ####################################################################################### */
+
+    /** Check whether hidden context was created, it can't be made current otherwise */
+    bool
+    valid() const
+    {
+        return m_window != nullptr;
+    }
+
+    /** Get uploads waiting for GPU */
+    std::size_t
+    pending() const;
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    struct Upload
+    {
+        void*
+        fence {nullptr};    // GLsync
+
+        std::function<void()>
+        ready {};
+    };
+
+    GLFWwindow*
+    m_window {nullptr};
+
+    mutable std::mutex
+    m_mutex;
+
+    std::vector<Upload>
+    m_pending {};
+
+    std::vector<Upload>
+    m_ready {};         // reused by 'collect'
+};
+
+EZWINDOW_NAMESPACE_END
+
+#endif
\ No newline at end of file
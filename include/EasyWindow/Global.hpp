@@ -1,25 +1,11 @@
 #pragma once
 
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
-#include <iostream>
 #include <type_traits>
-
-#define EZWINDOW_INFO(message) std::cout << "EasyWindow [info]: " << message << std::endl;
-
-/* --------------------------------------------------------------------------------------- */
-
-#define EZWINDOW_WARNING(message) std::cout << "EasyWindow [warning] in " << __FUNCTION__ << "(): " << message << std::endl << __FILE__ << ":" << __LINE__ << std::endl;
-
-/* --------------------------------------------------------------------------------------- */
-
-#define EZWINDOW_ERROR(message) std::cout << "EasyWindow [warning] in " << __FUNCTION__ << "(): " << message << std::endl << __FILE__ << ":" << __LINE__ << std::endl; exit(-1);
-
-/* --------------------------------------------------------------------------------------- */
-
-#define EZWINDOW                    ezwin
-#define EZWINDOW_NAMESPACE_BEGIN    namespace EZWINDOW {
-#define EZWINDOW_NAMESPACE_END      }
+#include <EasyWindow/Namespace.hpp>
 
 /* --------------------------------------------------------------------------------------- */
 
@@ -49,6 +35,80 @@ struct Size
 
 /* --------------------------------------------------------------------------------------- */
 
+/**
+ * Gets steady clock time (in nanoseconds).
+ */
+inline std::uint64_t
+nowNanoseconds()
+{
+    return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>
+    (
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count());
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+/**
+ * Non owning view over contiguous sequence of elements.
+ */
+template<typename T>
+class Span
+{
+
+/* ####################################################################################### */
+public: /* Constructors */
+/* ####################################################################################### */
+
+    constexpr
+    Span() = default;
+
+    constexpr
+    Span(const T* data, std::size_t size) : m_data(data), m_size(size) {}
+
+
+/* ####################################################################################### */
+public: /* Getters */
+/* ####################################################################################### */
+
+    /** Get pointer to first element */
+    constexpr const T*
+    data() const { return m_data; }
+
+    /** Get elements count */
+    constexpr std::size_t
+    size() const { return m_size; }
+
+    /** Check if there are no elements */
+    constexpr bool
+    empty() const { return m_size == 0; }
+
+    /** Get iterator to first element */
+    constexpr const T*
+    begin() const { return m_data; }
+
+    /** Get iterator past last element */
+    constexpr const T*
+    end() const { return m_data + m_size; }
+
+    /** Get element by index */
+    constexpr const T&
+    operator[](std::size_t index) const { return m_data[index]; }
+
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    const T*
+    m_data {nullptr};
+
+    std::size_t
+    m_size {0};
+};
+
+/* --------------------------------------------------------------------------------------- */
+
 template<typename T>
 constexpr std::enable_if_t<std::is_floating_point_v<T>,T>
 fit(T value, T omin, T omax, T nmin, T nmax)
@@ -63,4 +123,9 @@ fit(T value, T omin, T omax, T nmin, T nmax)
     }
 }
 
-EZWINDOW_NAMESPACE_END
\ No newline at end of file
+EZWINDOW_NAMESPACE_END
+
+/* --------------------------------------------------------------------------------------- */
+
+// Logging macros (EZWINDOW_INFO, EZWINDOW_WARNING, EZWINDOW_ERROR) come with Global.hpp
+#include <EasyWindow/Logger.hpp>
\ No newline at end of file
@@ -0,0 +1,144 @@
+#pragma once
+
+
+#include <bitset>
+#include <EasyWindow/Global.hpp>
+#include <EasyWindow/Enums/Keys.hpp>
+#include <EasyWindow/Enums/States.hpp>
+#include <EasyWindow/Enums/Buttons.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/**
+ * Keyboard and mouse buttons snapshot. Keeps packed bits of held keys and buttons
+ * plus press/release edges happened during current tick. Any GLFW key or button
+ * code can be queried by casting it to EKey/EButton.
+ */
+class InputState
+{
+
+/* ####################################################################################### */
+public: /* Constants */
+/* ####################################################################################### */
+
+    static constexpr std::size_t
+    KeysCount = 512;
+
+    static constexpr std::size_t
+    ButtonsCount = 8;
+
+/* ####################################################################################### */
+public: /* Queries */
+/* ####################################################################################### */
+
+    /** Check whether key is held down */
+    bool
+    isDown(EKey key) const
+    {
+        return validKey(key) && m_keysDown[std::size_t(key)];
+    }
+
+    /** Check whether button is held down */
+    bool
+    isDown(EButton button) const
+    {
+        return validButton(button) && m_buttonsDown[std::size_t(button)];
+    }
+
+    /** Check whether key was pressed during current tick */
+    bool
+    wasPressedThisFrame(EKey key) const
+    {
+        return validKey(key) && m_keysPressed[std::size_t(key)];
+    }
+
+    /** Check whether button was pressed during current tick */
+    bool
+    wasPressedThisFrame(EButton button) const
+    {
+        return validButton(button) && m_buttonsPressed[std::size_t(button)];
+    }
+
+    /** Check whether key was released during current tick */
+    bool
+    wasReleasedThisFrame(EKey key) const
+    {
+        return validKey(key) && m_keysReleased[std::size_t(key)];
+    }
+
+    /** Check whether button was released during current tick */
+    bool
+    wasReleasedThisFrame(EButton button) const
+    {
+        return validButton(button) && m_buttonsReleased[std::size_t(button)];
+    }
+
+/* ####################################################################################### */
+public: /* Modifiers */
+/* ####################################################################################### */
+
+    /**
+     * Forget press/release edges of previous tick.
+     */
+    void
+    beginFrame();
+
+    /**
+     * Apply key event.
+     * @param key Key code.
+     * @param state Key state.
+     */
+    void
+    setKey(EKey key, EState state);
+
+    /**
+     * Apply mouse button event.
+     * @param button Button code.
+     * @param state Button state.
+     */
+    void
+    setButton(EButton button, EState state);
+
+    /**
+     * Release all keys and buttons.
+     */
+    void
+    reset();
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    static constexpr bool
+    validKey(EKey key)
+    {
+        return std::size_t(key) < KeysCount;
+    }
+
+    static constexpr bool
+    validButton(EButton button)
+    {
+        return std::size_t(button) < ButtonsCount;
+    }
+
+    std::bitset<KeysCount>
+    m_keysDown {};
+
+    std::bitset<KeysCount>
+    m_keysPressed {};
+
+    std::bitset<KeysCount>
+    m_keysReleased {};
+
+    std::bitset<ButtonsCount>
+    m_buttonsDown {};
+
+    std::bitset<ButtonsCount>
+    m_buttonsPressed {};
+
+    std::bitset<ButtonsCount>
+    m_buttonsReleased {};
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
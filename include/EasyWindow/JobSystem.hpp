@@ -0,0 +1,276 @@
+#pragma once
+
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <initializer_list>
+#include <condition_variable>
+#include <EasyWindow/Global.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+struct WorkerStats
+{
+    std::uint64_t
+    jobs {0};           // executed jobs count
+
+    double
+    busy {0.0};         // time spent in jobs (in seconds)
+
+    double
+    utilization {0.0};  // busy time / time since stats reset
+};
+
+/**
+ * Work stealing thread pool running a per-frame graph of jobs. Jobs are submitted with
+ * dependencies (from any thread, including jobs themselves) and start once all of them
+ * are finished. Each worker takes newest jobs from its own queue and steals oldest ones
+ * from others when it runs out. Thread that waits for a job executes jobs meanwhile,
+ * it is counted as worker 0 in stats.
+ *
+ * Job ids are valid until the next 'beginFrame', which waits for all jobs of previous
+ * frame. Window calls 'beginFrame' before 'tickEvent' and waits for jobs marked with
+ * 'requireForRender' before 'clearEvent', other jobs may run along with rendering.
+ */
+class JobSystem
+{
+
+/* ####################################################################################### */
+public: /* Aliases */
+/* ####################################################################################### */
+
+    using JobId = std::uint32_t;
+
+/* ####################################################################################### */
+public: /* Constants */
+/* ####################################################################################### */
+
+    /** Invalid job id */
+    static constexpr JobId
+    NoJob = ~JobId(0);
+
+    /** Jobs are allocated in chunks, addresses are stable while frame goes on */
+    static constexpr std::uint32_t
+    ChunkSize = 1024;
+
+    /** Max jobs count per frame is ChunkSize * MaxChunks */
+    static constexpr std::uint32_t
+    MaxChunks = 256;
+
+/* ####################################################################################### */
+public: /* Constructors */
+/* ####################################################################################### */
+
+    ~JobSystem();
+
+    /**
+     * Starts worker threads.
+     * @param workersCount Threads count besides waiting thread, 0 for one less than hardware threads.
+     */
+    explicit
+    JobSystem(std::size_t workersCount = 0);
+
+    JobSystem(const JobSystem&) = delete;
+
+    JobSystem&
+    operator=(const JobSystem&) = delete;
+
+/* ####################################################################################### */
+public: /* Methods */
+/* ####################################################################################### */
+
+    /**
+     * Submit job.
+     * @param job Function to run.
+     * @param dependencies Jobs which have to finish before this one starts.
+     * @param name Job name in Trace timeline (string literal).
+     * @return Job id, NoJob if frame ran out of job slots and job was executed at once.
+     */
+    JobId
+    submit(std::function<void()> job, std::initializer_list<JobId> dependencies = {}, const char* name = "job");
+
+    /**
+     * Submit job.
+     * @param job Function to run.
+     * @param dependencies Jobs which have to finish before this one starts.
+     * @param name Job name in Trace timeline (string literal).
+     * @return Job id, NoJob if frame ran out of job slots and job was executed at once.
+     */
+    JobId
+    submit(std::function<void()> job, Span<JobId> dependencies, const char* name = "job");
+
+    /**
+     * Mark job as the one rendering depends on, window loop waits for it before 'clearEvent'.
+     * @param job Job id.
+     */
+    void
+    requireForRender(JobId job);
+
+    /**
+     * Wait for job to finish, executing other jobs meanwhile.
+     * @param job Job id.
+     */
+    void
+    wait(JobId job);
+
+    /**
+     * Wait for all jobs marked by 'requireForRender'.
+     */
+    void
+    waitForRender();
+
+    /**
+     * Wait for all submitted jobs.
+     */
+    void
+    waitAll();
+
+    /**
+     * Wait for all submitted jobs and start new frame, previous job ids become invalid.
+     */
+    void
+    beginFrame();
+
+    /**
+     * Clear workers stats.
+     */
+    void
+    resetStats();
+
+/* ####################################################################################### */
+public: /* Getters */
+/* ####################################################################################### */
+
+    /** Get worker threads count (waiting thread is not counted) */
+    std::size_t
+    workersCount() const
+    {
+        return m_threads.size();
+    }
+
+    /** Check whether job is finished (NoJob always is) */
+    bool
+    finished(JobId job) const;
+
+    /**
+     * Gets stats of each worker since last reset, index 0 is thread(s) waiting for jobs.
+     * @return Workers stats.
+     */
+    std::vector<WorkerStats>
+    workerStats() const;
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    struct Job
+    {
+        std::function<void()>
+        function {};
+
+        const char*
+        name {nullptr};
+
+        std::atomic<std::uint32_t>
+        pending {0};    // unfinished dependencies + 1 while job is being submitted
+
+        std::atomic<bool>
+        done {false};
+
+        std::mutex
+        mutex;          // guards successors against job finishing
+
+        std::vector<JobId>
+        successors {};
+    };
+
+    struct alignas(64) Worker
+    {
+        std::mutex
+        mutex;
+
+        std::deque<JobId>
+        queue {};
+
+        std::atomic<std::uint64_t>
+        jobs {0};
+
+        std::atomic<std::uint64_t>
+        busy {0};       // in nanoseconds
+    };
+
+    Job&
+    job(JobId id) const
+    {
+        return m_chunks[id / ChunkSize].load(std::memory_order_acquire)[id % ChunkSize];
+    }
+
+    std::size_t
+    currentWorker() const;
+
+    void
+    schedule(JobId id);
+
+    JobId
+    take(std::size_t worker);
+
+    bool
+    executeOne(std::size_t worker);
+
+    void
+    execute(JobId id, std::size_t worker);
+
+    void
+    workerLoop(std::size_t worker);
+
+    std::array<std::atomic<Job*>, MaxChunks>
+    m_chunks {};
+
+    std::vector<std::unique_ptr<Job[]>>
+    m_chunksStorage {};
+
+    std::mutex
+    m_chunksMutex;
+
+    std::atomic<std::uint32_t>
+    m_jobsCount {0};
+
+    std::atomic<std::uint32_t>
+    m_unfinished {0};
+
+    std::atomic<std::uint32_t>
+    m_queued {0};
+
+    std::vector<JobId>
+    m_renderJobs {};
+
+    std::mutex
+    m_renderJobsMutex;
+
+    std::unique_ptr<Worker[]>
+    m_workers {};
+
+    std::vector<std::thread>
+    m_threads {};
+
+    std::mutex
+    m_sleepMutex;
+
+    std::condition_variable
+    m_wake;
+
+    std::atomic<bool>
+    m_stop {false};
+
+    std::uint64_t
+    m_statsStart {0};
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
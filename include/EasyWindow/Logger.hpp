@@ -0,0 +1,358 @@
+#pragma once
+
+
+#include <string>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <EasyWindow/Global.hpp>
+#include <EasyWindow/Enums/LogLevel.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+struct LogEntry
+{
+    ELogLevel
+    level {ELogLevel::Info};
+
+    std::uint64_t
+    time {0};                   // steady clock time of logging call (in nanoseconds)
+
+    const char*
+    function {nullptr};
+
+    const char*
+    file {nullptr};
+
+    std::uint32_t
+    line {0};
+
+    std::string
+    message {};                 // formatted message
+};
+
+/** Function receiving formatted entries, called on logger thread */
+using LogSink = std::function<void(const LogEntry& entry)>;
+
+/* --------------------------------------------------------------------------------------- */
+
+/**
+ * Unformatted message as it is queued: call site and arguments in binary form.
+ */
+struct LogRecord
+{
+    static constexpr std::size_t
+    PayloadSize = 200;
+
+    ELogLevel
+    level {ELogLevel::Info};
+
+    std::uint64_t
+    time {0};
+
+    const char*
+    function {nullptr};
+
+    const char*
+    file {nullptr};
+
+    std::uint32_t
+    line {0};
+
+    std::uint16_t
+    size {0};                   // used payload bytes
+
+    bool
+    truncated {false};          // arguments didn't fit into payload
+
+    unsigned char
+    payload[PayloadSize];
+};
+
+/* --------------------------------------------------------------------------------------- */
+
+/**
+ * Process wide asynchronous logger. Logging thread only copies arguments into a record
+ * and pushes it into lock-free multi-producer queue, formatting and writing happens on
+ * logger thread (started by the first message). When the queue is full messages are
+ * dropped, logging thread never waits. Levels below EZWINDOW_LOG_LEVEL (0 info, 1 warning,
+ * 2 error, 3 none) are stripped at compile time, levels below 'setLevel' at run time.
+ */
+class Logger
+{
+
+/* ####################################################################################### */
+public: /* Settings */
+/* ####################################################################################### */
+
+    /**
+     * Set min level of logged messages.
+     * @param level Min level.
+     */
+    static void
+    setLevel(ELogLevel level);
+
+    /**
+     * Set function formatted entries are written to (console by default).
+     * @param sink Sink function (nullptr restores console).
+     */
+    static void
+    setSink(LogSink sink);
+
+    /** Check whether messages of level are logged */
+    static bool
+    enabled(ELogLevel level)
+    {
+        return level >= s_level.load(std::memory_order_relaxed);
+    }
+
+/* ####################################################################################### */
+public: /* Methods */
+/* ####################################################################################### */
+
+    /**
+     * Queue record (never blocks).
+     * @param record Message record.
+     */
+    static void
+    push(const LogRecord& record);
+
+    /**
+     * Wait until all messages queued so far are written. Must not be called from sink.
+     */
+    static void
+    flush();
+
+    /**
+     * Format message of record.
+     * @param record Message record.
+     * @return Formatted message.
+     */
+    static std::string
+    format(const LogRecord& record);
+
+/* ####################################################################################### */
+public: /* Getters */
+/* ####################################################################################### */
+
+    /**
+     * Gets count of messages dropped because queue was full.
+     * @return Dropped messages count.
+     */
+    static std::uint64_t
+    droppedMessages();
+
+    /**
+     * Gets count of logged errors.
+     * @return Errors count.
+     */
+    static std::uint64_t
+    errorsCount();
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    static std::atomic<ELogLevel>
+    s_level;
+};
+
+/* --------------------------------------------------------------------------------------- */
+
+/**
+ * Builds record from streamed arguments and queues it when destroyed. Strings
+ * are copied, numbers are stored as they are and formatted by logger thread.
+ */
+class LogMessage
+{
+
+/* ####################################################################################### */
+public: /* Argument tags */
+/* ####################################################################################### */
+
+    enum class EArgument : std::uint8_t
+    {
+        String          = 0,
+        Signed          = 1,
+        Unsigned        = 2,
+        Floating        = 3,
+        Char            = 4,
+        Bool            = 5,
+        Pointer         = 6
+    };
+
+/* ####################################################################################### */
+public: /* Constructors */
+/* ####################################################################################### */
+
+    LogMessage(ELogLevel level, const char* function, const char* file, std::uint32_t line)
+    {
+        m_record.level = level;
+        m_record.time = nowNanoseconds();
+        m_record.function = function;
+        m_record.file = file;
+        m_record.line = line;
+    }
+
+    ~LogMessage()
+    {
+        Logger::push(m_record);
+    }
+
+    LogMessage(const LogMessage&) = delete;
+
+    LogMessage&
+    operator=(const LogMessage&) = delete;
+
+/* ####################################################################################### */
+public: /* Operators */
+/* ####################################################################################### */
+
+    LogMessage&
+    operator<<(const char* text)
+    {
+        return putString(text ? text : "(null)", text ? std::strlen(text) : 6);
+    }
+
+    LogMessage&
+    operator<<(const unsigned char* text)
+    {
+        return *this << reinterpret_cast<const char*>(text);
+    }
+
+    LogMessage&
+    operator<<(const std::string& text)
+    {
+        return putString(text.data(), text.size());
+    }
+
+    LogMessage&
+    operator<<(char value)
+    {
+        return put(EArgument::Char, value);
+    }
+
+    LogMessage&
+    operator<<(bool value)
+    {
+        return put(EArgument::Bool, value);
+    }
+
+    LogMessage&
+    operator<<(const void* value)
+    {
+        return put(EArgument::Pointer, value);
+    }
+
+    template<typename T>
+    std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>, LogMessage&>
+    operator<<(T value)
+    {
+        if constexpr (std::is_enum_v<T>)
+        {
+            return *this << std::underlying_type_t<T>(value);
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            return put(EArgument::Floating, double(value));
+        }
+        else if constexpr (std::is_signed_v<T>)
+        {
+            return put(EArgument::Signed, std::int64_t(value));
+        }
+        else
+        {
+            return put(EArgument::Unsigned, std::uint64_t(value));
+        }
+    }
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    template<typename T>
+    LogMessage&
+    put(EArgument tag, const T& value)
+    {
+        if (m_record.size + 1 + sizeof(T) > LogRecord::PayloadSize)
+        {
+            m_record.truncated = true;
+            return *this;
+        }
+
+        m_record.payload[m_record.size] = std::uint8_t(tag);
+        std::memcpy(m_record.payload + m_record.size + 1, &value, sizeof(T));
+        m_record.size += std::uint16_t(1 + sizeof(T));
+
+        return *this;
+    }
+
+    LogMessage&
+    putString(const char* text, std::size_t length)
+    {
+        const std::size_t header = 1 + sizeof(std::uint16_t);
+        const std::size_t space = LogRecord::PayloadSize - m_record.size;
+
+        if (space <= header)
+        {
+            m_record.truncated = true;
+            return *this;
+        }
+
+        if (length > space - header)
+        {
+            length = space - header;
+            m_record.truncated = true;
+        }
+
+        const auto size = std::uint16_t(length);
+        m_record.payload[m_record.size] = std::uint8_t(EArgument::String);
+        std::memcpy(m_record.payload + m_record.size + 1, &size, sizeof(size));
+        std::memcpy(m_record.payload + m_record.size + header, text, length);
+        m_record.size += std::uint16_t(header + length);
+
+        return *this;
+    }
+
+    LogRecord
+    m_record;
+};
+
+EZWINDOW_NAMESPACE_END
+
+/* --------------------------------------------------------------------------------------- */
+
+#ifndef EZWINDOW_LOG_LEVEL
+    #define EZWINDOW_LOG_LEVEL 0
+#endif
+
+#define EZWINDOW_LOG(level, message)                                                                \
+    do                                                                                              \
+    {                                                                                               \
+        if (::EZWINDOW::Logger::enabled(level))                                                     \
+        {                                                                                           \
+            ::EZWINDOW::LogMessage(level, __FUNCTION__, __FILE__, __LINE__) << message;             \
+        }                                                                                           \
+    }                                                                                               \
+    while (false)
+
+#if EZWINDOW_LOG_LEVEL <= 0
+    #define EZWINDOW_INFO(message) EZWINDOW_LOG(::EZWINDOW::ELogLevel::Info, message)
+#else
+    #define EZWINDOW_INFO(message) do {} while (false)
+#endif
+
+#if EZWINDOW_LOG_LEVEL <= 1
+    #define EZWINDOW_WARNING(message) EZWINDOW_LOG(::EZWINDOW::ELogLevel::Warning, message)
+#else
+    #define EZWINDOW_WARNING(message) do {} while (false)
+#endif
+
+#if EZWINDOW_LOG_LEVEL <= 2
+    #define EZWINDOW_ERROR(message) EZWINDOW_LOG(::EZWINDOW::ELogLevel::Error, message)
+#else
+    #define EZWINDOW_ERROR(message) do {} while (false)
+#endif
\ No newline at end of file
@@ -0,0 +1,6 @@
+#pragma once
+
+
+#define EZWINDOW                    ezwin
+#define EZWINDOW_NAMESPACE_BEGIN    namespace EZWINDOW {
+#define EZWINDOW_NAMESPACE_END      }
\ No newline at end of file
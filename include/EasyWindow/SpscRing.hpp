@@ -0,0 +1,143 @@
+#pragma once
+
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <EasyWindow/Global.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/**
+ * Lock-free fixed capacity ring buffer for one producer thread and one consumer thread.
+ * @tparam T Trivially copyable element type.
+ * @tparam Capacity Max elements count (power of two).
+ */
+template<typename T, std::size_t Capacity>
+class SpscRing
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscRing capacity must be power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "SpscRing element must be trivially copyable");
+
+/* ####################################################################################### */
+public: /* Methods */
+/* ####################################################################################### */
+
+    /**
+     * Push element (producer thread only).
+     * @param value Element to push.
+     * @return False if ring is full.
+     */
+    bool
+    push(const T& value)
+    {
+        const auto head = m_head.load(std::memory_order_relaxed);
+
+        if (head - m_tailCache == Capacity)
+        {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+            if (head - m_tailCache == Capacity)
+            {
+                return false;
+            }
+        }
+
+        m_data[head & Mask] = value;
+        m_head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Pop element (consumer thread only).
+     * @param value Popped element.
+     * @return False if ring is empty.
+     */
+    bool
+    pop(T& value)
+    {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+
+        if (tail == m_headCache)
+        {
+            m_headCache = m_head.load(std::memory_order_acquire);
+            if (tail == m_headCache)
+            {
+                return false;
+            }
+        }
+
+        value = m_data[tail & Mask];
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Pass all currently available elements to function and remove them (consumer thread only).
+     * @param func Function called for each element.
+     * @return Consumed elements count.
+     */
+    template<typename Func>
+    std::size_t
+    consume(Func&& func)
+    {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        m_headCache = m_head.load(std::memory_order_acquire);
+
+        for (auto i = tail; i != m_headCache; ++i)
+        {
+            func(static_cast<const T&>(m_data[i & Mask]));
+        }
+
+        m_tail.store(m_headCache, std::memory_order_release);
+
+        return m_headCache - tail;
+    }
+
+    /** Get approximate elements count */
+    std::size_t
+    size() const
+    {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+    /** Check whether ring is (approximately) empty */
+    bool
+    empty() const
+    {
+        return size() == 0;
+    }
+
+    /** Get max elements count */
+    static constexpr std::size_t
+    capacity()
+    {
+        return Capacity;
+    }
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    static constexpr std::size_t
+    Mask = Capacity - 1;
+
+    alignas(64) std::atomic<std::size_t>
+    m_head {0};
+
+    std::size_t
+    m_tailCache {0};
+
+    alignas(64) std::atomic<std::size_t>
+    m_tail {0};
+
+    std::size_t
+    m_headCache {0};
+
+    alignas(64) T
+    m_data[Capacity] {};
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
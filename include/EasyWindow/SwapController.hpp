@@ -0,0 +1,88 @@
+#pragma once
+
+
+#include <array>
+#include <EasyWindow/Global.hpp>
+#include <EasyWindow/Enums/SwapInterval.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/**
+ * Chooses swap interval for requested mode. In ESwapInterval::Auto it watches recent
+ * tick deltas: if vsync makes frames miss vertical blank (frame rate drops to a half
+ * of refresh rate) it switches to immediate presentation, and goes back to vsync
+ * once frames comfortably fit into refresh period again.
+ */
+class SwapController
+{
+
+/* ####################################################################################### */
+public: /* Constants */
+/* ####################################################################################### */
+
+    /** Frames policy decision is based on */
+    static constexpr std::size_t
+    HistorySize = 32;
+
+/* ####################################################################################### */
+public: /* Methods */
+/* ####################################################################################### */
+
+    /**
+     * Set swap mode.
+     * @param mode Swap mode.
+     * @param tearSupported Whether platform can present late frames at once (swap control tear).
+     */
+    void
+    setMode(ESwapInterval mode, bool tearSupported);
+
+    /**
+     * Feed duration of presented frame and update interval.
+     * @param tickDelta Time between current and previous ticks (in seconds).
+     * @param idleTime Part of tick delta previous frame spent in swap and pacing (in seconds).
+     * @param refreshRate Refresh rate of window monitor (0 if unknown).
+     * @return True if interval changed.
+     */
+    bool
+    update(double tickDelta, double idleTime, double refreshRate);
+
+/* ####################################################################################### */
+public: /* Getters */
+/* ####################################################################################### */
+
+    /** Get requested swap mode */
+    ESwapInterval
+    mode() const
+    {
+        return m_mode;
+    }
+
+    /** Get swap interval to apply: 0 immediate, 1 vsync, -1 vsync with late swap tear */
+    int
+    interval() const
+    {
+        return m_interval;
+    }
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    ESwapInterval
+    m_mode {ESwapInterval::VSync};
+
+    int
+    m_interval {1};
+
+    std::array<double, HistorySize>
+    m_history {};
+
+    std::size_t
+    m_historyCount {0};
+
+    std::size_t
+    m_historyIndex {0};
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
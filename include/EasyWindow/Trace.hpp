@@ -0,0 +1,151 @@
+#pragma once
+
+
+#include <string>
+#include <atomic>
+#include <EasyWindow/Global.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/**
+ * Process wide timeline recorder. Each thread writes complete events into its own
+ * fixed capacity buffer without locks, buffers are exported as Chrome trace JSON
+ * (chrome://tracing, ui.perfetto.dev). Event names must outlive the trace (use
+ * string literals). Recording is off until 'setEnabled(true)'.
+ */
+class Trace
+{
+
+/* ####################################################################################### */
+public: /* Settings */
+/* ####################################################################################### */
+
+    /**
+     * Enable or disable recording.
+     * @param enabled Enabled or disabled recording.
+     */
+    static void
+    setEnabled(bool enabled);
+
+    /**
+     * Set events count each thread buffer can hold. Affects buffers of threads
+     * which did not record anything yet. When buffer is full new events are dropped.
+     * @param capacity Events count.
+     */
+    static void
+    setBufferCapacity(std::size_t capacity);
+
+    /**
+     * Set name of calling thread shown in trace viewer.
+     * @param name Thread name.
+     */
+    static void
+    setThreadName(const std::string& name);
+
+    /** Check whether recording is enabled */
+    static bool
+    enabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+/* ####################################################################################### */
+public: /* Methods */
+/* ####################################################################################### */
+
+    /**
+     * Record complete event on calling thread.
+     * @param name Event name (must outlive the trace).
+     * @param start Event start (steady clock, in nanoseconds).
+     * @param duration Event duration (in nanoseconds).
+     */
+    static void
+    record(const char* name, std::uint64_t start, std::uint64_t duration);
+
+    /**
+     * Write all recorded events as Chrome trace JSON.
+     * @param path File path.
+     * @return True if file was written.
+     */
+    static bool
+    write(const std::string& path);
+
+    /**
+     * Remove recorded events. Call it when no thread is recording.
+     */
+    static void
+    clear();
+
+    /**
+     * Gets count of events dropped because thread buffers were full.
+     * @return Dropped events count.
+     */
+    static std::uint64_t
+    droppedEvents();
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    static std::atomic<bool>
+    s_enabled;
+};
+
+/* --------------------------------------------------------------------------------------- */
+
+/**
+ * Records its lifetime as trace event.
+ */
+class TraceScope
+{
+
+/* ####################################################################################### */
+public: /* Constructors */
+/* ####################################################################################### */
+
+    explicit
+    TraceScope(const char* name)
+        : m_name(Trace::enabled() ? name : nullptr)
+        , m_start(m_name ? nowNanoseconds() : 0)
+    {
+
+    }
+
+    ~TraceScope()
+    {
+        if (m_name)
+        {
+            Trace::record(m_name, m_start, nowNanoseconds() - m_start);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+
+    TraceScope&
+    operator=(const TraceScope&) = delete;
+
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    const char*
+    m_name {nullptr};          // null while tracing is disabled
+
+    std::uint64_t
+    m_start {0};
+};
+
+EZWINDOW_NAMESPACE_END
+
+/* --------------------------------------------------------------------------------------- */
+
+#define EZWINDOW_TRACE_CONCAT_IMPL(a, b) a##b
+#define EZWINDOW_TRACE_CONCAT(a, b) EZWINDOW_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef EZWINDOW_NO_TRACE
+    #define EZWINDOW_TRACE_SCOPE(name)
+#else
+    #define EZWINDOW_TRACE_SCOPE(name) ::EZWINDOW::TraceScope EZWINDOW_TRACE_CONCAT(ezwindowTraceScope, __LINE__) (name);
+#endif
\ No newline at end of file
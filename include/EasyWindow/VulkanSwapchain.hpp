@@ -0,0 +1,313 @@
+#pragma once
+
+
+#ifdef EZWINDOW_VULKAN
+
+#include <vector>
+#include <functional>
+#include <vulkan/vulkan.h>
+#include <EasyWindow/Global.hpp>
+#include <EasyWindow/Enums/PresentMode.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+struct VulkanSwapchainConfig
+{
+    VkPhysicalDevice
+    physicalDevice {VK_NULL_HANDLE};
+
+    VkDevice
+    device {VK_NULL_HANDLE};
+
+    VkQueue
+    presentQueue {VK_NULL_HANDLE};  // queue frames are presented to
+
+    VkSurfaceKHR
+    surface {VK_NULL_HANDLE};       // surface created by 'Window::createVulkanSurface', owned by user
+
+    std::uint32_t
+    framesInFlight {2};             // frames CPU may record while GPU is busy with previous ones
+
+    EPresentMode
+    presentMode {EPresentMode::Fifo};
+
+    VkSurfaceFormatKHR
+    format {VK_FORMAT_B8G8R8A8_SRGB, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR};
+
+    VkImageUsageFlags
+    imageUsage {VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT};
+
+    const VkAllocationCallbacks*
+    allocator {nullptr};
+};
+
+/** Function receiving start and duration of each present (in nanoseconds) */
+using PresentHook = std::function<void(std::uint64_t start, std::uint64_t duration)>;
+
+/* --------------------------------------------------------------------------------------- */
+
+struct VulkanFrame
+{
+    std::uint32_t
+    slot {0};                           // frame in flight index
+
+    std::uint32_t
+    imageIndex {0};
+
+    VkImage
+    image {VK_NULL_HANDLE};
+
+    VkImageView
+    view {VK_NULL_HANDLE};
+
+    VkExtent2D
+    extent {0, 0};
+
+    VkSemaphore
+    acquired {VK_NULL_HANDLE};          // submit has to wait for it before writing the image
+
+    VkSemaphore
+    rendered {VK_NULL_HANDLE};          // submit has to signal it, present waits for it
+
+    VkFence
+    fence {VK_NULL_HANDLE};             // submit has to signal it, frame slot is reused after it
+};
+
+/**
+ * Swapchain with a ring of frames in flight. Typical frame is:
+ *
+ *     VulkanFrame frame;
+ *     if (swapchain.acquire(frame))
+ *     {
+ *         // record commands, submit waiting 'acquired', signaling 'rendered' and 'fence'
+ *         swapchain.present(frame);
+ *     }
+ *
+ * Swapchain is recreated when it becomes out of date, suboptimal, resized or present mode
+ * changes. The device is never drained: new swapchain is created with 'oldSwapchain' and the
+ * retired one is destroyed once all frames which could use it passed their fences.
+ */
+class VulkanSwapchain
+{
+
+/* ####################################################################################### */
+public: /* Constructors */
+/* ####################################################################################### */
+
+    ~VulkanSwapchain();
+
+    /**
+     * Creates swapchain.
+     * @param config Devices, surface and swapchain params.
+     * @param extent Size used if surface doesn't define it (window framebuffer size).
+     */
+    VulkanSwapchain(const VulkanSwapchainConfig& config, VkExtent2D extent);
+
+    VulkanSwapchain(const VulkanSwapchain&) = delete;
+
+    VulkanSwapchain&
+    operator=(const VulkanSwapchain&) = delete;
+
+/* ####################################################################################### */
+public: /* Methods */
+/* ####################################################################################### */
+
+    /**
+     * Waits until frame slot is free and acquires next image (recreating swapchain if needed).
+     * @param frame Acquired frame.
+     * @return False if there is nothing to render into (window is minimized) or acquire failed.
+     */
+    bool
+    acquire(VulkanFrame& frame);
+
+    /**
+     * Presents frame and moves to the next frame slot.
+     * @param frame Frame returned by 'acquire'.
+     * @return Present result (out of date and suboptimal are handled internally).
+     */
+    VkResult
+    present(const VulkanFrame& frame);
+
+    /**
+     * Request recreation with new size, applied by next 'acquire'.
+     * @param extent Window framebuffer size.
+     */
+    void
+    resize(VkExtent2D extent);
+
+    /**
+     * Request present mode, applied by next 'acquire'. Unsupported mode falls back
+     * to the closest supported one (Fifo in the end).
+     * @param mode Present mode.
+     */
+    void
+    setPresentMode(EPresentMode mode);
+
+    /**
+     * Set function called after each present, window owning swapchain uses it
+     * to measure swap time.
+     * @param hook Hook function (nullptr disables it).
+     */
+    void
+    setPresentHook(PresentHook hook);
+
+/* ####################################################################################### */
+public: /* Getters */
+/* ####################################################################################### */
+
+    /** Get devices, surface and params swapchain was created with */
+    const VulkanSwapchainConfig&
+    config() const
+    {
+        return m_config;
+    }
+
+    /** Get swapchain handle */
+    VkSwapchainKHR
+    handle() const
+    {
+        return m_swapchain;
+    }
+
+    /** Get format of swapchain images */
+    VkSurfaceFormatKHR
+    format() const
+    {
+        return m_format;
+    }
+
+    /** Get size of swapchain images */
+    VkExtent2D
+    extent() const
+    {
+        return m_extent;
+    }
+
+    /** Get present mode in use (may differ from requested one) */
+    EPresentMode
+    presentMode() const
+    {
+        return m_presentMode;
+    }
+
+    /** Get swapchain images count */
+    std::uint32_t
+    imagesCount() const
+    {
+        return std::uint32_t(m_images.size());
+    }
+
+    /** Get frames in flight count */
+    std::uint32_t
+    framesInFlight() const
+    {
+        return std::uint32_t(m_slots.size());
+    }
+
+    /** Get how many times swapchain was recreated */
+    std::uint64_t
+    recreationsCount() const
+    {
+        return m_recreations;
+    }
+
+    /** Get retired swapchains waiting for frames which could use them */
+    std::uint32_t
+    retiredCount() const
+    {
+        return std::uint32_t(m_retired.size());
+    }
+
+/* ####################################################################################### */
+private: /* Internals */
+/* ####################################################################################### */
+
+    struct Slot
+    {
+        VkSemaphore
+        acquired {VK_NULL_HANDLE};
+
+        VkFence
+        fence {VK_NULL_HANDLE};
+    };
+
+    struct Retired
+    {
+        VkSwapchainKHR
+        swapchain {VK_NULL_HANDLE};
+
+        std::vector<VkImageView>
+        views {};
+
+        std::vector<VkSemaphore>
+        rendered {};
+
+        std::uint64_t
+        frame {0};      // frames counter when swapchain was retired
+    };
+
+    bool
+    recreate();
+
+    void
+    collectRetired(bool all);
+
+    void
+    destroyImages(std::vector<VkImageView>& views, std::vector<VkSemaphore>& rendered);
+
+    VkPresentModeKHR
+    choosePresentMode();
+
+    VulkanSwapchainConfig
+    m_config {};
+
+    VkSwapchainKHR
+    m_swapchain {VK_NULL_HANDLE};
+
+    VkSurfaceFormatKHR
+    m_format {};
+
+    VkExtent2D
+    m_extent {0, 0};
+
+    VkExtent2D
+    m_requestedExtent {0, 0};
+
+    EPresentMode
+    m_presentMode {EPresentMode::Fifo};
+
+    std::vector<VkImage>
+    m_images {};
+
+    std::vector<VkImageView>
+    m_views {};
+
+    std::vector<VkSemaphore>
+    m_rendered {};      // per image, image is reacquired only after its present was consumed
+
+    std::vector<Slot>
+    m_slots {};
+
+    std::vector<Retired>
+    m_retired {};
+
+    PresentHook
+    m_presentHook {};
+
+    std::uint32_t
+    m_slot {0};
+
+    std::uint64_t
+    m_frame {0};
+
+    std::uint64_t
+    m_recreations {0};
+
+    bool
+    m_outdated {true};
+};
+
+EZWINDOW_NAMESPACE_END
+
+#endif
\ No newline at end of file
@@ -1,14 +1,38 @@
 #pragma once
 
 
+#include <atomic>
 #include <chrono>
+#include <mutex>
 #include <string>
 #include <vector>
+#include <memory>
+#include <condition_variable>
+#include <EasyWindow/Event.hpp>
 #include <EasyWindow/Global.hpp>
+#include <EasyWindow/Trace.hpp>
+#include <EasyWindow/SpscRing.hpp>
+#include <EasyWindow/EventReplay.hpp>
+#include <EasyWindow/EventRecorder.hpp>
+#include <EasyWindow/FrameClock.hpp>
+#include <EasyWindow/FrameStats.hpp>
+#include <EasyWindow/FrameCapture.hpp>
+#include <EasyWindow/JobSystem.hpp>
+#include <EasyWindow/InputState.hpp>
+#include <EasyWindow/FramePacer.hpp>
+#include <EasyWindow/WindowConfig.hpp>
+#include <EasyWindow/SwapController.hpp>
+#include <EasyWindow/GLStreamBuffer.hpp>
+#include <EasyWindow/GLUploadContext.hpp>
+#include <EasyWindow/VulkanSwapchain.hpp>
 #include <EasyWindow/Enums/Keys.hpp>
 #include <EasyWindow/Enums/States.hpp>
 #include <EasyWindow/Enums/Buttons.hpp>
 #include <EasyWindow/Enums/Modifiers.hpp>
+#include <EasyWindow/Enums/LoopMode.hpp>
+#include <EasyWindow/Enums/FramePacing.hpp>
+#include <EasyWindow/Enums/SwapInterval.hpp>
+#include <EasyWindow/Enums/TaskWait.hpp>
 #include <EasyWindow/Enums/OriginCorner.hpp>
 
 
@@ -16,15 +40,8 @@ class GLFWwindow;
 
 EZWINDOW_NAMESPACE_BEGIN
 
-struct ChannelsBits
-{
-    std::uint32_t r {8};     // red
-    std::uint32_t g {8};     // green
-    std::uint32_t b {8};     // blue
-    std::uint32_t a {8};     // alpha
-    std::uint32_t d {32};    // depth
-    std::uint32_t s {16};    // stencil
-};
+class Application;
+class FrameAwaiter;
 
 struct MouseOffset
 {
@@ -38,8 +55,64 @@ struct MouseOffset
     rel11Value {};
 };
 
+struct MouseMotion
+{
+    Vector<double>
+    position {};    // last cursor position in current tick
+
+    Vector<double>
+    delta {};       // cursor movement accumulated over current tick
+
+    std::uint32_t
+    samples {0};    // cursor events count in current tick
+};
+
+struct MouseSample
+{
+    Vector<double>
+    position {};
+
+    std::uint64_t
+    timestamp {0};  // steady clock time (in nanoseconds)
+};
+
+struct TaskWait
+{
+    ETaskWait
+    kind {ETaskWait::Frame};
+
+    double
+    time {0.0};                     // window time to resume at (ETaskWait::Time)
+
+    EEventType
+    type {EEventType::Key};         // event to resume on (ETaskWait::Event)
+
+    std::int32_t
+    code {0};
+
+    std::int32_t
+    action {0};
+};
+
+struct SuspendedTask
+{
+    void*
+    handle {nullptr};               // coroutine handle address
+
+    void
+    (*resume)(void*) {nullptr};
+
+    void
+    (*destroy)(void*) {nullptr};
+
+    Event*
+    event {nullptr};                // receives event task was resumed by
+};
+
 class Window
 {
+    friend class Application;
+    friend class FrameAwaiter;
 
 /* ####################################################################################### */
 public: /* Constructors */
@@ -51,20 +124,64 @@ public: /* Constructors */
     explicit
     Window(EOriginCorner originCorner);
 
+    /**
+     * Creates window which shares context objects (OpenGL) with another window.
+     * @param originCorner Mouse coordinates origin.
+     * @param shareContext Window to share context with (nullptr to not share).
+     */
+    Window(EOriginCorner originCorner, Window* shareContext);
+
+    /**
+     * Creates window with given attributes. Creation of GLFW window and context is
+     * postponed until 'create' if config is deferred.
+     * @param config Window attributes.
+     */
+    explicit
+    Window(const WindowConfig& config);
+
+/* ####################################################################################### */
+public: /* Process wide settings */
+/* ####################################################################################### */
+
+    /**
+     * Enable or disable headless mode for windows created afterwards. Headless windows
+     * are invisible. OpenGL ones use hidden window on a display (Xvfb with llvmpipe)
+     * if DISPLAY is set, GLEW loads functions through GLX. Otherwise, and always with
+     * Vulkan, they use GLFW null platform if it is supported (no display server, OpenGL
+     * through OSMesa if GLEW can load its functions, Vulkan through headless surface).
+     * Platform choice takes effect when GLFW is initialized, so call it before any
+     * window or application is created.
+     * @param enabled Enabled or disabled headless mode.
+     */
+    static void
+    setHeadless(bool enabled);
+
+    /** Check whether headless mode is enabled */
+    static bool
+    headless();
+
+    /**
+     * Start loading window system and render backend libraries (Vulkan loader and ICDs,
+     * OpenGL library) on background thread, so the first window is created faster.
+     * Call it from main thread as early as possible. GLFW itself is still initialized
+     * by the first window or application, as it has to be done from main thread.
+     */
+    static void
+    preloadPlatform();
 
 /* ####################################################################################### */
 public: /* Properties setters */
 /* ####################################################################################### */
 
     /**
-     * Set window size.
+     * Set window size. Call from main thread only.
      * @param size Window size.
      */
     void
     setSize(const Size<uint64_t>& size);
 
     /**
-     * Set window visibility
+     * Set window visibility (shows or hides already created window)
      * @param visible Window visibility
      */
     void
@@ -78,26 +195,130 @@ public: /* Properties setters */
     setTitle(const std::string& title);
 
     /**
-     * Set window samples
+     * Set window samples. Takes effect only if window is not created yet.
      * @param samplesCount Window samples count
      */
     void
     setSamples(int samplesCount);
 
     /**
-     * Set double buffer enabled or disabled
+     * Set double buffer enabled or disabled. Takes effect only if window is not created yet.
      * @param enabled Enabled or disabled double buffer
      */
     void
     setDoubleBufferEnabled(bool enabled);
 
     /**
-     * Set window channel bits.
+     * Set window channel bits. Takes effect only if window is not created yet.
      * @param bits Channel bits depth
      */
     void
     setChannelsBits(const ChannelsBits& bits);
 
+    /**
+     * Set event loop mode. In ELoopMode::OnDemand loop sleeps until an event arrives
+     * and calls 'clearEvent' and 'renderEvent' only if window input, resize or
+     * 'requestRedraw' marked window as dirty.
+     * @param mode Loop mode.
+     * @param idleTimeout Max time to wait for events (in seconds), 0 waits infinitely.
+     */
+    void
+    setLoopMode(ELoopMode mode, double idleTimeout = 0.0);
+
+    /**
+     * Set file frame stats are written to when event loop finishes. Format is chosen
+     * by extension: CSV for '.csv', JSON otherwise. Empty path disables writing.
+     * @param path File path.
+     */
+    void
+    setFrameStatsPath(const std::string& path);
+
+    /**
+     * Set recorder every event received from window system is written to.
+     * @param recorder Event recorder (nullptr stops recording).
+     */
+    void
+    setEventRecorder(EventRecorder* recorder);
+
+    /**
+     * Set replay whose events are appended to each tick batch when they are due
+     * by window time (in real time with 'run', by synthetic time with 'runFrames').
+     * @param replay Event replay (nullptr stops replaying).
+     */
+    void
+    setEventReplay(EventReplay* replay);
+
+    /**
+     * Set job system running per-frame jobs. Window starts its frame with 'beginFrame'
+     * before 'tickEvent' and waits for jobs required for render before 'clearEvent'.
+     * @param jobs Job system (nullptr detaches it).
+     */
+    void
+    setJobSystem(JobSystem* jobs);
+
+    /**
+     * Enable or disable separate render thread. When enabled 'run' dedicates calling
+     * (main) thread to event pumping, while render thread owns context (OpenGL) and
+     * calls all window event handlers, from 'beforeLoop' to 'afterLoop'. Input is
+     * forwarded through lock-free queue. Must be set before 'run'.
+     * @param enabled Enabled or disabled render thread.
+     */
+    void
+    setThreadedRendering(bool enabled);
+
+    /**
+     * Enable or disable mouse motion coalescing. When enabled consecutive cursor
+     * events of a tick produce single 'mouseMoveEvent' call with the last position,
+     * accumulated movement is available through 'mouseMotion'.
+     * @param enabled Enabled or disabled coalescing.
+     */
+    void
+    setMouseMotionCoalescing(bool enabled);
+
+    /**
+     * Set max count of cursor samples kept per tick (0 disables history).
+     * Samples are available through 'mouseMotionHistory'.
+     * @param capacity Max samples count.
+     */
+    void
+    setMouseMotionHistory(std::size_t capacity);
+
+    /**
+     * Lock and hide cursor, so mouse reports unbounded virtual position. Deferred window
+     * applies it when created. Call from main thread only.
+     * @param locked Locked or released cursor.
+     */
+    void
+    setCursorLocked(bool locked);
+
+    /**
+     * Enable or disable raw (unaccelerated, unscaled) mouse motion if platform supports it.
+     * Takes effect while cursor is locked, deferred window applies it when created.
+     * Call from main thread only.
+     * @param enabled Enabled or disabled raw motion.
+     * @return True if raw motion is supported.
+     */
+    bool
+    setRawMouseMotion(bool enabled);
+
+    /**
+     * Set how event loop paces frames.
+     * @param pacing Pacing mode.
+     * @param rate Frames per second (used by EFramePacing::TargetRate only).
+     */
+    void
+    setFramePacing(EFramePacing pacing, double rate = 60.0);
+
+    /**
+     * Set swap interval mode. It is applied by the thread owning context at the start
+     * of next frame, until then driver default is used. ESwapInterval::Adaptive relies on
+     * swap control tear extension (GLX/WGL) and falls back to vsync without it.
+     * With Vulkan it selects present mode of swapchain created by 'createVulkanSwapchain'.
+     * @param mode Swap interval mode.
+     */
+    void
+    setSwapInterval(ESwapInterval mode);
+
 /* ####################################################################################### */
 public: /* Platform data pointers */
 /* ####################################################################################### */
@@ -116,10 +337,81 @@ public: /* Platform data pointers */
     void*
     nativeDisplayType();
 
+    /**
+     * Gets underlying GLFW window pointer.
+     * @param GLFW window pointer.
+     */
+    GLFWwindow*
+    glfwWindow()
+    {
+        return m_window;
+    }
+
 /* ####################################################################################### */
 public: /* Render backend methods */
 /* ####################################################################################### */
 
+#ifdef EZWINDOW_OPENGL
+    /**
+     * Creates streaming upload ring owned by window (replacing previous one). Window
+     * ends its frame in 'swapFrameBuffers'. Context has to be current on calling thread.
+     * @param frameSize Bytes each frame may allocate.
+     * @param framesCount Frames in flight.
+     * @return Stream buffer.
+     */
+    GLStreamBuffer&
+    createStreamBuffer(std::uint64_t frameSize, std::uint32_t framesCount = 3);
+
+    /**
+     * Destroys stream buffer owned by window. Context has to be current on calling thread.
+     */
+    void
+    destroyStreamBuffer();
+
+    /**
+     * Gets stream buffer owned by window.
+     * @return Stream buffer, nullptr if it was not created.
+     */
+    GLStreamBuffer*
+    streamBuffer()
+    {
+        return m_streamBuffer.get();
+    }
+
+    /**
+     * Creates hidden contexts sharing objects with window context, one per worker thread
+     * uploading resources (replacing previous ones). Uploads finished by workers are
+     * handed off on render thread before 'tickEvent'. Main thread only, window has to be created.
+     * @param count Contexts count.
+     */
+    void
+    createUploadContexts(std::size_t count);
+
+    /**
+     * Destroys upload contexts, they must not be current on any thread. Main thread only.
+     */
+    void
+    destroyUploadContexts();
+
+    /**
+     * Gets upload context.
+     * @param index Context index.
+     * @return Upload context.
+     */
+    GLUploadContext&
+    uploadContext(std::size_t index)
+    {
+        return *m_uploadContexts[index];
+    }
+
+    /** Get upload contexts count */
+    std::size_t
+    uploadContextsCount() const
+    {
+        return m_uploadContexts.size();
+    }
+#endif
+
 #ifdef EZWINDOW_VULKAN
     /**
      * Creates VkSurface object.
@@ -135,6 +427,61 @@ public: /* Render backend methods */
      */
     static std::vector<std::string>
     vulkanExtensions();
+
+    /**
+     * Creates swapchain owned by window (replacing previous one). Window keeps it sized
+     * to the window and maps 'setSwapInterval' to its present mode. Destroy it before
+     * destroying device or surface it was created with.
+     * @param config Devices, surface and swapchain params.
+     * @return Swapchain.
+     */
+    VulkanSwapchain&
+    createVulkanSwapchain(const VulkanSwapchainConfig& config);
+
+    /**
+     * Destroys swapchain owned by window.
+     */
+    void
+    destroyVulkanSwapchain();
+
+    /**
+     * Gets swapchain owned by window.
+     * @return Swapchain, nullptr if it was not created.
+     */
+    VulkanSwapchain*
+    vulkanSwapchain()
+    {
+        return m_swapchain.get();
+    }
+#endif
+
+#if defined(EZWINDOW_OPENGL) || defined(EZWINDOW_VULKAN)
+    /**
+     * Starts capturing frames to disk (replacing previous capture). OpenGL back buffer is
+     * read by 'swapFrameBuffers', context has to be current on calling thread. With Vulkan
+     * frames are captured by 'FrameCapture::record', window swapchain has to be created
+     * with VK_IMAGE_USAGE_TRANSFER_SRC_BIT and capture is stopped when it is destroyed.
+     * @param config Output and readback params.
+     * @return False if capture can't be started.
+     */
+    bool
+    startCapture(const CaptureConfig& config);
+
+    /**
+     * Completes pending readbacks, writes queued frames and stops capture.
+     */
+    void
+    stopCapture();
+
+    /**
+     * Gets running capture.
+     * @return Capture, nullptr if it was not started.
+     */
+    FrameCapture*
+    frameCapture()
+    {
+        return m_capture.get();
+    }
 #endif
 
 /* ####################################################################################### */
@@ -148,6 +495,34 @@ public: /* Getters */
         return m_size;
     }
 
+    /** Get window framebuffer size (in pixels, differs from window size on HiDPI displays) */
+    Size<uint64_t>
+    framebufferSize() const
+    {
+        return m_framebufferSize;
+    }
+
+    /** Get ratio between current DPI and platform default DPI */
+    Vector<float>
+    contentScale() const
+    {
+        return m_contentScale;
+    }
+
+    /** Get job system set by 'setJobSystem' */
+    JobSystem*
+    jobSystem() const
+    {
+        return m_jobs;
+    }
+
+    /** Check whether GLFW window and context are created */
+    bool
+    created() const
+    {
+        return m_window != nullptr;
+    }
+
     /** Is window visible */
     bool
     visible() const
@@ -183,8 +558,158 @@ public: /* Getters */
         return m_channels;
     }
 
+    /** Get event loop mode */
+    ELoopMode
+    loopMode() const
+    {
+        return m_loopMode;
+    }
+
+    /** Check whether event handlers run on separate render thread */
+    bool
+    threadedRendering() const
+    {
+        return m_threadedRendering;
+    }
+
+    /** Get frame pacing mode */
+    EFramePacing
+    framePacing() const
+    {
+        return m_pacing;
+    }
+
+    /** Get frames per second event loop is paced to (0 if unlimited) */
+    double
+    frameRateLimit() const
+    {
+        return m_pacer.targetRate();
+    }
+
+    /** Get requested swap interval mode */
+    ESwapInterval
+    swapIntervalMode() const
+    {
+        return m_swap.mode();
+    }
+
+    /**
+     * Gets swap interval currently in use: 0 immediate, 1 vsync, -1 vsync with late swap tear.
+     * In ESwapInterval::Auto it changes as frame times do.
+     * @return Swap interval.
+     */
+    int
+    swapInterval() const
+    {
+        return m_swap.interval();
+    }
+
+    /**
+     * Gets time spent in 'swapFrameBuffers' (present of window swapchain with Vulkan)
+     * by the last rendered frame (in seconds).
+     * @return Swap duration.
+     */
+    double
+    swapDuration() const
+    {
+        return double(m_lastSwapDuration) * 1e-9;
+    }
+
+    /**
+     * Gets time the frame limiter inserted at the end of previous frame (in seconds).
+     * @return Frame wait time.
+     */
+    double
+    frameWaitTime() const
+    {
+        return m_pacer.lastWait();
+    }
+
+    /**
+     * Gets durations of event loop phases (poll, dispatch, tick, clear, render, swap, wait)
+     * collected since window creation or last reset. When Trace is enabled the same
+     * phases and each dispatched event are recorded to the timeline as well. Main thread polling is not
+     * recorded while render thread is running.
+     * @return Frame stats.
+     */
+    const FrameStats&
+    frameStats() const
+    {
+        return m_stats;
+    }
+
+    /**
+     * Clears collected frame stats. Call it between frames only.
+     */
+    void
+    resetFrameStats()
+    {
+        m_stats.reset();
+    }
+
+    /**
+     * Gets refresh rate of monitor the window is on (fullscreen monitor or
+     * the one containing window center). Main thread only.
+     * @return Refresh rate in Hz, 0 if unknown.
+     */
+    double
+    monitorRefreshRate();
+
+    /**
+     * Gets all events received by window for current tick (in order of arrival).
+     * Events are dispatched to handlers in one batch right before 'tickEvent',
+     * view is valid until next tick.
+     * @return Current tick events.
+     */
+    Span<Event>
+    frameEvents() const
+    {
+        return {m_frameEvents, m_frameEventsCount};
+    }
+
+    /**
+     * Gets keyboard and mouse buttons snapshot of current tick. Queries don't touch GLFW.
+     * @return Input state.
+     */
+    const InputState&
+    input() const
+    {
+        return m_input;
+    }
+
+    /**
+     * Gets mouse movement accumulated over current tick (sub-pixel precision).
+     * @return Mouse motion.
+     */
+    const MouseMotion&
+    mouseMotion() const
+    {
+        return m_motion;
+    }
+
+    /**
+     * Gets cursor samples received in current tick (bounded by 'setMouseMotionHistory').
+     * @return Mouse samples.
+     */
+    Span<MouseSample>
+    mouseMotionHistory() const
+    {
+        return {m_motionHistory.data(), m_motionHistoryCount};
+    }
+
+    /**
+     * Gets count of events dropped because event queue was full.
+     * @return Dropped events count.
+     */
+    std::uint64_t
+    droppedEvents() const
+    {
+        return m_droppedEvents.load(std::memory_order_relaxed);
+    }
+
     /**
-     * Gets mouse position.
+     * Gets mouse position. Position is sampled once per tick from cursor events,
+     * so it doesn't cost a round trip to window system.
      * @return mouse position.
      */
     Vector<uint64_t>
@@ -198,7 +723,7 @@ public: /* Getters */
     mouseOffset();
 
     /**
-     * Checks is mouse in window area.
+     * Checks is mouse in window area (tracked from cursor enter/leave events).
      * @return True if mouse in window area, false otherwise.
      */
     bool
@@ -218,6 +743,17 @@ public: /* Getters */
     double
     tickDelta() const;
 
+    /**
+     * Gets frame clock: integer time and tick delta (in nanoseconds), frame number
+     * and recent frame times with their min, max, average and smoothed value.
+     * @return Frame clock.
+     */
+    const FrameClock&
+    clock() const
+    {
+        return m_clock;
+    }
+
     /**
      * Gets window aspect ratio (width / height).
      * @return Aspect ratio.
@@ -230,18 +766,124 @@ public: /* Getters */
 public: /* Methods */
 /* ####################################################################################### */
 
+    /**
+     * Create GLFW window and context with attributes set so far. Called by constructor
+     * unless config is deferred. Call from main thread only.
+     */
+    void
+    create();
+
     /**
      * Start window main loop.
      */
     virtual void
     run();
 
+    /**
+     * Run exactly 'count' iterations of tick/clear/render pipeline as fast as possible,
+     * between 'beforeLoop' and 'afterLoop'. Events are polled without waiting, every
+     * iteration renders, no pacing is done and no render thread is started. Time is
+     * synthetic: it starts at zero and advances by 'timeStep' each iteration.
+     * @param count Iterations count.
+     * @param timeStep Synthetic tick delta (in seconds).
+     */
+    void
+    runFrames(std::uint64_t count, double timeStep = 1.0 / 60.0);
+
     /**
      * Close window.
      */
     virtual void
     close();
 
+    /**
+     * Mark window as dirty and wake up event loop. In ELoopMode::OnDemand next
+     * loop iteration renders a frame. Can be called from any thread.
+     */
+    void
+    requestRedraw();
+
+    /**
+     * Inject synthetic event into window event queue. It is dispatched with the next
+     * tick batch like events received from window system. Call it from thread pumping
+     * events (the one 'run' was called from).
+     * @param event Event to inject (timestamp is overwritten).
+     */
+    void
+    injectEvent(Event event);
+
+    /**
+     * Inject synthetic key event.
+     * @param key Input key.
+     * @param state Key state.
+     * @param modifier Modifier key pressed.
+     */
+    void
+    injectKey(EKey key, EState state, EModifier modifier = EModifier(0));
+
+    /**
+     * Inject synthetic mouse button event.
+     * @param button Input button.
+     * @param state Button state.
+     * @param modifier Modifier key pressed.
+     */
+    void
+    injectButton(EButton button, EState state, EModifier modifier = EModifier(0));
+
+    /**
+     * Inject synthetic cursor event.
+     * @param position Cursor position (in screen coordinates, origin at top left).
+     */
+    void
+    injectMouseMove(Vector<double> position);
+
+    /**
+     * Inject synthetic scroll event.
+     * @param offset Scroll offset.
+     */
+    void
+    injectScroll(Vector<double> offset);
+
+    /**
+     * Inject synthetic resize event. Framebuffer is resized keeping its current ratio to window size.
+     * @param size New window size.
+     */
+    void
+    injectResize(const Size<uint64_t>& size);
+
+    /**
+     * Gets awaitable resuming coroutine on the next frame (see FrameTask.hpp).
+     * @return Frame awaiter.
+     */
+    FrameAwaiter
+    nextFrame();
+
+    /**
+     * Gets awaitable resuming coroutine once window time advanced by given duration.
+     * @param duration Time to wait (in seconds).
+     * @return Frame awaiter.
+     */
+    FrameAwaiter
+    seconds(double duration);
+
+    /**
+     * Gets awaitable resuming coroutine on frame which received given key event.
+     * @param key Key to wait for.
+     * @param state Key state to wait for.
+     * @return Frame awaiter.
+     */
+    FrameAwaiter
+    nextKey(EKey key, EState state = EState::Press);
+
+    /**
+     * Gets awaitable resuming coroutine on frame which received given mouse button event.
+     * @param button Button to wait for.
+     * @param state Button state to wait for.
+     * @return Frame awaiter.
+     */
+    FrameAwaiter
+    nextButton(EButton button, EState state = EState::Press);
+
     /**
      * Swap frame buffers.
      */
@@ -268,7 +910,7 @@ public: /* Methods */
     relative01(const Vector<uint64_t>& pos) const;
 
     /**
-     * Gets state of key.
+     * Gets state of key (from current tick snapshot).
      * @param key Key to check.
      * @return key state.
      */
@@ -276,13 +918,48 @@ public: /* Methods */
     keyState(EKey key);
 
     /**
-     * Gets state of mouse button.
+     * Gets state of mouse button (from current tick snapshot).
      * @param button Button to check.
      * @return button state.
      */
     EState
     buttonState(EButton button);
 
+/* ####################################################################################### */
+protected: /* Handlers dispatch */
+/* ####################################################################################### */
+
+    /** Calls handlers of window for dispatched event */
+    using EventDispatch = void (*)(Window& window, const Event& event);
+
+    /** Event types mask with every type */
+    static constexpr std::uint32_t
+    AllEvents = ~std::uint32_t(0);
+
+    /**
+     * Creates window with custom handlers dispatch (see BasicWindow).
+     * @param config Window attributes.
+     * @param eventMask Bits of event types GLFW callbacks are registered for (window
+     * size related ones are registered always).
+     * @param dispatch Function calling handlers.
+     */
+    Window(const WindowConfig& config, std::uint32_t eventMask, EventDispatch dispatch);
+
+    /** Get bit of event type in event mask */
+    static constexpr std::uint32_t
+    eventBit(EEventType type)
+    {
+        return std::uint32_t(1) << std::uint32_t(type);
+    }
+
+    /** Get mouse move event position relative to window origin corner */
+    Vector<uint64_t>
+    eventPosition(const Event& event) const
+    {
+        const double ys[2] = {event.y, double(m_size.h) - event.y};
+        return {uint64_t(event.x), uint64_t(ys[uint8_t(m_originCorner)])};
+    }
+
 /* ####################################################################################### */
 protected: /* Window events */
 /* ####################################################################################### */
@@ -318,7 +995,8 @@ protected: /* Window events */
     afterLoop();
 
     /**
-     * Resize event handler.
+     * Resize event handler. Called at most once per tick, after all tick events were
+     * dispatched, if window size, framebuffer size or content scale changed.
      */
     virtual void
     resizeEvent();
@@ -366,24 +1044,148 @@ protected: /* Window events */
 private: /* Internals */
 /* ####################################################################################### */
 
+    static bool
+    acquirePlatform();
+
+    static void
+    releasePlatform();
+
+    static void
+    setDefaultShareContext(Window* window);
+
+    void
+    pollEvents();
+
+    /**
+     * Gets how long OnDemand loop may wait for events: idle timeout limited by tasks waiting
+     * for next frame or time and by pending uploads, GPU can't wake event loop.
+     * @return Timeout in seconds, 0 to wait without timeout.
+     */
+    double
+    eventWaitTimeout() const;
+
+    bool
+    frame();
+
+    void
+    paceFrame();
+
+    void
+    recordPhase(EFramePhase phase, std::uint64_t start, std::uint64_t duration);
+
+    /**
+     * Account buffers swap (Vulkan present) of current frame.
+     * @param start Swap start time (in nanoseconds).
+     * @param duration Swap duration (in nanoseconds).
+     */
+    void
+    recordSwap(std::uint64_t start, std::uint64_t duration);
+
+    void
+    endLoop();
+
+    void
+    runThreaded();
+
+    void
+    renderLoop();
+
+    void
+    wakeRenderThread();
+
+    void
+    postEvent(Event event);
+
+    void
+    enqueueEvent(const Event& event);
+
+    void
+    drainEvents();
+
+    void
+    dispatchEvent(const Event& event);
+
+    static void
+    dispatchHandlers(Window& window, const Event& event);
+
+    void
+    sampleCursor();
+
+    void
+    trackMotion(const Event& event);
+
+    void
+    updateFramePacing();
+
+    void
+    updateSwapInterval();
+
+    void
+    suspendTask(const TaskWait& wait, const SuspendedTask& task);
+
+    void
+    resumeTasks();
+
+    void
+    markDirty()
+    {
+        m_redraw.store(true, std::memory_order_release);
+    }
+
     GLFWwindow*
     m_window {nullptr};
 
+    bool
+    m_platform {false};     // GLFW was initialized for this window
+
+    const std::uint32_t
+    m_eventMask;
+
+    const EventDispatch
+    m_dispatch;
+
     MouseOffset
     m_prev_tick_mouse_pos {};
 
-    double
-    m_time = 0.0;
+    FrameClock
+    m_clock {};
 
     double
-    m_curr_tick = 0.0;
+    m_timeStep = 0.0;
 
-    double
-    m_prev_tick = 0.0;
+    FrameStats
+    m_stats {};
+
+    std::string
+    m_statsPath {};
+
+    std::uint64_t
+    m_swapDuration {0};
+
+    std::uint64_t
+    m_lastSwapDuration {0};
+
+    SwapController
+    m_swap {};
+
+    bool
+    m_swapTearSupported {false};
+
+    bool
+    m_swapPending {false};
+
+    bool
+    m_presented {false};
+
+    bool
+    m_waited {false};       // loop blocked waiting for events before current frame
 
     const EOriginCorner
     m_originCorner;
 
+    Window*
+    m_shareContext {nullptr};
+
     ChannelsBits
     m_channels {};
 
@@ -393,6 +1195,15 @@ private: /* Internals */
     Size<uint64_t>
     m_size {1280, 720};
 
+    Size<uint64_t>
+    m_framebufferSize {1280, 720};
+
+    Vector<float>
+    m_contentScale {1.0f};
+
+    bool
+    m_resized {false};
+
     uint32_t
     m_samples {0};
 
@@ -401,6 +1212,120 @@ private: /* Internals */
 
     bool
     m_doubleBuffer {true};
+
+    FramePacer
+    m_pacer {};
+
+    EFramePacing
+    m_pacing {EFramePacing::Unlimited};
+
+    double
+    m_targetRate {60.0};
+
+    ELoopMode
+    m_loopMode {ELoopMode::Continuous};
+
+    double
+    m_idleTimeout {0.0};
+
+    std::atomic<bool>
+    m_redraw {true};
+
+    std::atomic<double>
+    m_monitorRate {0.0};
+
+    Vector<double>
+    m_cursor {0.0};
+
+    bool
+    m_cursorKnown {false};
+
+    Vector<uint64_t>
+    m_mousePosition {0};
+
+    MouseMotion
+    m_motion {};
+
+    InputState
+    m_input {};
+
+    bool
+    m_coalesceMotion {false};
+
+    bool
+    m_cursorLocked {false};     // input modes are applied by 'create' for deferred window
+
+    bool
+    m_rawMouseMotion {false};
+
+    std::vector<MouseSample>
+    m_motionHistory {};
+
+    std::size_t
+    m_motionHistoryCount {0};
+
+    bool
+    m_cursorInside {false};
+
+    bool
+    m_threadedRendering {false};
+
+    std::atomic<bool>
+    m_renderThreadActive {false};
+
+    std::mutex
+    m_wakeMutex;
+
+    std::condition_variable
+    m_wakeCondition;
+
+    static constexpr std::size_t
+    EventsCapacity = 1024;
+
+    SpscRing<Event, EventsCapacity>
+    m_events;
+
+    Event
+    m_frameEvents[EventsCapacity] {};
+
+    std::size_t
+    m_frameEventsCount {0};
+
+    std::atomic<std::uint64_t>
+    m_droppedEvents {0};
+
+    EventRecorder*
+    m_recorder {nullptr};
+
+    EventReplay*
+    m_replay {nullptr};
+
+    JobSystem*
+    m_jobs {nullptr};
+
+    std::vector<std::pair<TaskWait, SuspendedTask>>
+    m_tasks {};
+
+    std::vector<std::pair<TaskWait, SuspendedTask>>
+    m_resumedTasks {};
+
+#ifdef EZWINDOW_OPENGL
+    std::unique_ptr<GLStreamBuffer>
+    m_streamBuffer {};
+
+    std::vector<std::unique_ptr<GLUploadContext>>
+    m_uploadContexts {};
+#endif
+
+#ifdef EZWINDOW_VULKAN
+    std::unique_ptr<VulkanSwapchain>
+    m_swapchain {};
+#endif
+
+#if defined(EZWINDOW_OPENGL) || defined(EZWINDOW_VULKAN)
+    std::unique_ptr<FrameCapture>
+    m_capture {};
+#endif
 };
 
 
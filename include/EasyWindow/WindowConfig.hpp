@@ -0,0 +1,60 @@
+#pragma once
+
+
+#include <string>
+#include <EasyWindow/Global.hpp>
+#include <EasyWindow/Enums/OriginCorner.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+class Window;
+
+struct ChannelsBits
+{
+    std::uint32_t r {8};     // red
+    std::uint32_t g {8};     // green
+    std::uint32_t b {8};     // blue
+    std::uint32_t a {8};     // alpha
+    std::uint32_t d {32};    // depth
+    std::uint32_t s {16};    // stencil
+};
+
+/**
+ * Attributes window and its context are created with. Window system can't change
+ * most of them later, so they are all given at once instead of through setters.
+ */
+struct WindowConfig
+{
+    EOriginCorner
+    originCorner {EOriginCorner::TopLeft};  // mouse coordinates origin
+
+    Size<uint64_t>
+    size {1280, 720};
+
+    std::string
+    title {"Easy Window"};
+
+    bool
+    visible {true};
+
+    std::uint32_t
+    samples {0};                            // multisampling samples count
+
+    bool
+    doubleBuffer {true};
+
+    ChannelsBits
+    channels {};
+
+    Window*
+    shareContext {nullptr};                 // window to share context objects with (OpenGL)
+
+    bool
+    deferred {false};                       // don't create window until 'Window::create' is called
+
+    bool
+    maskUnhandledEvents {false};            // BasicWindow skips mouse callbacks Derived has no handler for
+};
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,275 @@
+#include <EasyWindow/Application.hpp>
+#include <EasyWindow/Logger.hpp>
+
+#ifdef EZWINDOW_OPENGL
+    #include <GL/glew.h>
+#endif
+
+#include <GLFW/glfw3.h>
+
+#include <iterator>
+#include <algorithm>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/* ####################################################################################### */
+/* Constructors */
+/* ####################################################################################### */
+
+Application::~Application()
+{
+    m_pending.clear();
+    m_windows.clear();
+
+    if (m_platform)
+    {
+        Window::releasePlatform();
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+Application::Application()
+{
+    m_platform = Window::acquirePlatform();
+
+    if (!m_platform)
+    {
+        EZWINDOW_ERROR("Cant initialize GLFW");
+    }
+}
+
+/* ####################################################################################### */
+/* Properties setters */
+/* ####################################################################################### */
+
+void
+Application::setContextSharing(bool enabled)
+{
+    m_contextSharing = enabled;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Application::setFramePacing(EFramePacing pacing, double rate)
+{
+    m_pacing = pacing;
+    m_targetRate = rate;
+    updateFramePacing();
+}
+
+/* ####################################################################################### */
+/* Methods */
+/* ####################################################################################### */
+
+void
+Application::run()
+{
+    if (!m_platform)
+    {
+        EZWINDOW_ERROR("Cant run application. GLFW was not initialized.");
+        return;
+    }
+
+    m_running = true;
+
+    startWindows(m_windows);
+
+    updateFramePacing();
+    m_pacer.reset();
+
+    for (;;)
+    {
+        // Windows created by previous iteration join the loop
+        if (!m_pending.empty())
+        {
+            auto started = std::move(m_pending);
+            m_pending.clear();
+
+            startWindows(started);
+            std::move(started.begin(), started.end(), std::back_inserter(m_windows));
+            updateFramePacing();
+        }
+
+        if (m_windows.empty())
+        {
+            break;
+        }
+
+        pollEvents();
+
+        bool rendered = false;
+
+        for (auto it = m_windows.begin(); it != m_windows.end();)
+        {
+            Window& window = **it;
+
+#ifdef EZWINDOW_OPENGL
+            glfwMakeContextCurrent(window.m_window);
+#endif
+
+            if (glfwWindowShouldClose(window.m_window))
+            {
+                window.endLoop();
+                it = m_windows.erase(it);
+                continue;
+            }
+
+            rendered = window.frame() || rendered;
+            ++it;
+        }
+
+        if (rendered)
+        {
+            updateFramePacing();
+            m_pacer.wait();
+        }
+    }
+
+    m_running = false;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Application::quit()
+{
+    for (auto& window : m_windows)
+    {
+        window->close();
+    }
+
+    // Windows waiting to join the loop are never opened
+    m_pending.clear();
+}
+
+/* ####################################################################################### */
+/* Internals */
+/* ####################################################################################### */
+
+void
+Application::pollEvents()
+{
+    bool wait = true;
+    double timeout = 0.0;
+
+    for (const auto& window : m_windows)
+    {
+        if (window->m_loopMode == ELoopMode::Continuous || window->m_redraw.load(std::memory_order_acquire))
+        {
+            wait = false;
+            break;
+        }
+
+        const double windowTimeout = window->eventWaitTimeout();
+
+        if (windowTimeout > 0.0)
+        {
+            timeout = timeout > 0.0 ? std::min(timeout, windowTimeout) : windowTimeout;
+        }
+    }
+
+    if (!wait)
+    {
+        const auto start = nowNanoseconds();
+        glfwPollEvents();
+        const auto duration = nowNanoseconds() - start;
+
+        for (auto& window : m_windows)
+        {
+            window->m_stats.record(EFramePhase::Poll, duration);
+        }
+
+        if (Trace::enabled())
+        {
+            Trace::record(FrameStats::phaseName(EFramePhase::Poll), start, duration);
+        }
+    }
+    else
+    {
+        if (timeout > 0.0)
+        {
+            glfwWaitEventsTimeout(timeout);
+        }
+        else
+        {
+            glfwWaitEvents();
+        }
+
+        for (auto& window : m_windows)
+        {
+            window->m_waited = true;
+        }
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Application::startWindows(std::vector<std::unique_ptr<Window>>& windows)
+{
+    for (auto it = windows.begin(); it != windows.end();)
+    {
+        Window& window = **it;
+
+        // Deferred windows are created in order, so shared contexts already exist
+        if (!window.created())
+        {
+            window.create();
+        }
+
+        if (!window.created())
+        {
+            EZWINDOW_WARNING("Window was not created, it is removed from event loop");
+            it = windows.erase(it);
+            continue;
+        }
+
+        window.m_monitorRate = window.monitorRefreshRate();
+        window.sampleCursor();
+
+#ifdef EZWINDOW_OPENGL
+        glfwMakeContextCurrent(window.m_window);
+#endif
+        window.beforeLoop();
+        ++it;
+    }
+
+    // Windows started together share loop start
+    const auto start = nowNanoseconds();
+    for (auto& window : windows)
+    {
+        window->m_clock.reset(start);
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Application::updateFramePacing()
+{
+    double rate = 0.0;
+
+    switch (m_pacing)
+    {
+        case EFramePacing::Unlimited:   rate = 0.0; break;
+        case EFramePacing::TargetRate:  rate = m_targetRate; break;
+        case EFramePacing::MonitorRate:
+        {
+            for (const auto& window : m_windows)
+            {
+                rate = std::max(rate, window->m_monitorRate.load(std::memory_order_relaxed));
+            }
+            break;
+        }
+    }
+
+    if (rate != m_pacer.targetRate())
+    {
+        m_pacer.setTargetRate(rate);
+    }
+}
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
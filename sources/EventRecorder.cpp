@@ -0,0 +1,77 @@
+#include <EasyWindow/EventRecorder.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+namespace
+{
+    constexpr std::size_t
+    FileBufferSize = 1 << 20;
+}
+
+/* ####################################################################################### */
+/* Constructors */
+/* ####################################################################################### */
+
+EventRecorder::~EventRecorder()
+{
+    close();
+}
+
+/* ####################################################################################### */
+/* Methods */
+/* ####################################################################################### */
+
+bool
+EventRecorder::open(const std::string& path)
+{
+    close();
+
+    m_file = std::fopen(path.data(), "wb");
+
+    if (!m_file)
+    {
+        return false;
+    }
+
+    // Events are small, let stdio batch them into large writes
+    std::setvbuf(m_file, nullptr, _IOFBF, FileBufferSize);
+
+    const EventRecordingHeader header {};
+    std::fwrite(&header, sizeof(header), 1, m_file);
+
+    m_start = nowNanoseconds();
+    m_count = 0;
+
+    return true;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+EventRecorder::close()
+{
+    if (m_file)
+    {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+EventRecorder::record(Event event)
+{
+    if (!m_file)
+    {
+        return;
+    }
+
+    event.timestamp = event.timestamp > m_start ? event.timestamp - m_start : 0;
+
+    std::fwrite(&event, sizeof(event), 1, m_file);
+    ++m_count;
+}
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
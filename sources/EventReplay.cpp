@@ -0,0 +1,157 @@
+#include <EasyWindow/EventReplay.hpp>
+#include <EasyWindow/EventRecorder.hpp>
+
+#include <cstring>
+
+#ifdef EZWINDOW_WINDOWS
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/* ####################################################################################### */
+/* Constructors */
+/* ####################################################################################### */
+
+EventReplay::~EventReplay()
+{
+    close();
+}
+
+/* ####################################################################################### */
+/* Methods */
+/* ####################################################################################### */
+
+bool
+EventReplay::open(const std::string& path)
+{
+    close();
+
+#ifdef EZWINDOW_WINDOWS
+    HANDLE file = CreateFileA(path.data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size {};
+    GetFileSizeEx(file, &size);
+
+    HANDLE mapping = size.QuadPart > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    CloseHandle(file);
+
+    if (!mapping)
+    {
+        return false;
+    }
+
+    m_mapping = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    m_mappingSize = std::size_t(size.QuadPart);
+    CloseHandle(mapping);
+#else
+    const int file = ::open(path.data(), O_RDONLY);
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat info {};
+    ::fstat(file, &info);
+
+    void* mapping = info.st_size > 0 ? ::mmap(nullptr, std::size_t(info.st_size), PROT_READ, MAP_PRIVATE, file, 0) : MAP_FAILED;
+    ::close(file);
+
+    m_mapping = mapping == MAP_FAILED ? nullptr : mapping;
+    m_mappingSize = std::size_t(info.st_size);
+#endif
+
+    if (!m_mapping)
+    {
+        m_mappingSize = 0;
+        return false;
+    }
+
+    const EventRecordingHeader expected {};
+    const auto* header = static_cast<const EventRecordingHeader*>(m_mapping);
+
+    const bool valid =
+        m_mappingSize >= sizeof(EventRecordingHeader) &&
+        std::memcmp(header->magic, expected.magic, sizeof(expected.magic)) == 0 &&
+        header->version == expected.version &&
+        header->eventSize == expected.eventSize;
+
+    if (!valid)
+    {
+        close();
+        return false;
+    }
+
+    m_events = reinterpret_cast<const Event*>(static_cast<const char*>(m_mapping) + sizeof(EventRecordingHeader));
+    m_count = (m_mappingSize - sizeof(EventRecordingHeader)) / sizeof(Event);
+
+    restart();
+
+    return true;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+EventReplay::close()
+{
+    if (m_mapping)
+    {
+#ifdef EZWINDOW_WINDOWS
+        UnmapViewOfFile(m_mapping);
+#else
+        ::munmap(m_mapping, m_mappingSize);
+#endif
+    }
+
+    m_mapping = nullptr;
+    m_mappingSize = 0;
+    m_events = nullptr;
+    m_count = 0;
+    m_cursor = 0;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+EventReplay::restart()
+{
+    m_cursor = 0;
+    m_start = -1.0;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+Span<Event>
+EventReplay::advance(double time, std::size_t maxCount)
+{
+    if (m_start < 0.0)
+    {
+        m_start = time;
+    }
+
+    const auto elapsed = std::uint64_t((time - m_start) * 1e9);
+    const auto first = m_cursor;
+
+    while (m_cursor < m_count && m_cursor - first < maxCount && m_events[m_cursor].timestamp <= elapsed)
+    {
+        ++m_cursor;
+    }
+
+    return {m_events + first, m_cursor - first};
+}
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
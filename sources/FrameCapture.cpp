@@ -0,0 +1,496 @@
+#include <EasyWindow/FrameCapture.hpp>
+#include <EasyWindow/Logger.hpp>
+
+#ifdef EZWINDOW_OPENGL
+    #include <GL/glew.h>
+#endif
+
+#include <algorithm>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+namespace
+{
+#ifdef EZWINDOW_OPENGL
+    /** Wait timeout per glClientWaitSync call when capture stops (in nanoseconds) */
+    constexpr GLuint64
+    WaitTimeout = 1000000000;
+#endif
+
+#ifdef EZWINDOW_VULKAN
+    /** Memory type with all required flags, preferring cached memory (fast CPU reads) */
+    std::uint32_t
+    findMemoryType(const VkPhysicalDeviceMemoryProperties& properties, std::uint32_t allowed)
+    {
+        const VkMemoryPropertyFlags required = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        std::uint32_t result = VK_MAX_MEMORY_TYPES;
+
+        for (std::uint32_t i = 0; i < properties.memoryTypeCount; ++i)
+        {
+            const VkMemoryPropertyFlags flags = properties.memoryTypes[i].propertyFlags;
+
+            if ((allowed & (1u << i)) == 0 || (flags & required) != required)
+            {
+                continue;
+            }
+
+            if (flags & VK_MEMORY_PROPERTY_HOST_CACHED_BIT)
+            {
+                return i;
+            }
+
+            result = std::min(result, i);
+        }
+
+        return result;
+    }
+#endif
+}
+
+/* ####################################################################################### */
+/* Constructors */
+/* ####################################################################################### */
+
+FrameCapture::~FrameCapture()
+{
+#ifdef EZWINDOW_OPENGL
+    collect(true);
+#endif
+
+#ifdef EZWINDOW_VULKAN
+    // Capture stop is the only place waiting for GPU
+    vkDeviceWaitIdle(m_swapchain->config().device);
+
+    while (m_slots[m_head].pending)
+    {
+        submit(m_slots[m_head]);
+        m_head = (m_head + 1) % m_slotsCount;
+    }
+#endif
+
+    // Writer is joined before memory it reads is freed
+    m_writer.reset();
+
+    for (std::uint32_t i = 0; i < m_slotsCount; ++i)
+    {
+        release(m_slots[i]);
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+#ifdef EZWINDOW_OPENGL
+FrameCapture::FrameCapture(const CaptureConfig& config)
+    : m_config(config)
+    , m_writer(std::make_unique<FrameWriter>(config.path, config.format, config.frameRate))
+    , m_slots(std::make_unique<Slot[]>(std::max(config.readbackSlots, 1u)))
+    , m_slotsCount(std::max(config.readbackSlots, 1u))
+    , m_flipped(true)
+{
+}
+#endif
+
+/* --------------------------------------------------------------------------------------- */
+
+#ifdef EZWINDOW_VULKAN
+FrameCapture::FrameCapture(const CaptureConfig& config, const VulkanSwapchain& swapchain)
+    : m_config(config)
+    , m_writer(std::make_unique<FrameWriter>(config.path, config.format, config.frameRate))
+    , m_slots(std::make_unique<Slot[]>(swapchain.framesInFlight() + std::max(config.readbackSlots, 1u)))
+    , m_slotsCount(swapchain.framesInFlight() + std::max(config.readbackSlots, 1u))
+    , m_swapchain(&swapchain)
+{
+    vkGetPhysicalDeviceMemoryProperties(swapchain.config().physicalDevice, &m_memory);
+}
+#endif
+
+/* ####################################################################################### */
+/* Methods */
+/* ####################################################################################### */
+
+#ifdef EZWINDOW_OPENGL
+void
+FrameCapture::readBack(std::uint32_t width, std::uint32_t height)
+{
+    collect(false);
+
+    Slot& slot = m_slots[m_next];
+
+    // GPU or writer still uses the oldest slot, capturing would stall the frame
+    if (slot.pending || slot.busy.load(std::memory_order_acquire))
+    {
+        m_dropped++;
+        return;
+    }
+
+    if (width == 0 || height == 0 || !reserve(slot, std::uint64_t(width) * height * 4))
+    {
+        return;
+    }
+
+    GLint readFramebuffer = 0;
+    GLint packBuffer = 0;
+    GLint packAlignment = 4;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFramebuffer);
+    glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &packBuffer);
+    glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    // Copy into pack buffer is queued, glReadPixels returns immediately
+    glReadPixels(0, 0, GLsizei(width), GLsizei(height), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, GLuint(packBuffer));
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, GLuint(readFramebuffer));
+
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.pending = true;
+    slot.index = m_frame++;
+    slot.width = width;
+    slot.height = height;
+
+    m_next = (m_next + 1) % m_slotsCount;
+}
+#endif
+
+/* --------------------------------------------------------------------------------------- */
+
+#ifdef EZWINDOW_VULKAN
+void
+FrameCapture::record(VkCommandBuffer commands, const VulkanFrame& frame)
+{
+    collect(frame.slot);
+
+    Slot& slot = m_slots[m_next];
+
+    if (slot.pending || slot.busy.load(std::memory_order_acquire))
+    {
+        m_dropped++;
+        return;
+    }
+
+    const VkFormat format = m_swapchain->format().format;
+
+    if (format != VK_FORMAT_R8G8B8A8_UNORM && format != VK_FORMAT_R8G8B8A8_SRGB &&
+        format != VK_FORMAT_B8G8R8A8_UNORM && format != VK_FORMAT_B8G8R8A8_SRGB)
+    {
+        if (!m_unsupported)
+        {
+            EZWINDOW_WARNING("Capture supports only 8 bit RGBA and BGRA swapchain formats");
+            m_unsupported = true;
+        }
+        return;
+    }
+
+    if (!reserve(slot, std::uint64_t(frame.extent.width) * frame.extent.height * 4))
+    {
+        return;
+    }
+
+    slot.bgra = format == VK_FORMAT_B8G8R8A8_UNORM || format == VK_FORMAT_B8G8R8A8_SRGB;
+
+    VkImageMemoryBarrier toTransfer {};
+    toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    toTransfer.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    toTransfer.oldLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransfer.image = frame.image;
+    toTransfer.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    toTransfer.subresourceRange.levelCount = 1;
+    toTransfer.subresourceRange.layerCount = 1;
+
+    vkCmdPipelineBarrier
+    (
+        commands,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0, 0, nullptr, 0, nullptr, 1, &toTransfer
+    );
+
+    VkBufferImageCopy region {};
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = 1;
+    region.imageExtent = {frame.extent.width, frame.extent.height, 1};
+
+    vkCmdCopyImageToBuffer(commands, frame.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, slot.buffer, 1, &region);
+
+    VkBufferMemoryBarrier toHost {};
+    toHost.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    toHost.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    toHost.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    toHost.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toHost.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toHost.buffer = slot.buffer;
+    toHost.size = VK_WHOLE_SIZE;
+
+    VkImageMemoryBarrier toPresent = toTransfer;
+    toPresent.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    toPresent.dstAccessMask = 0;
+    toPresent.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    toPresent.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+    vkCmdPipelineBarrier
+    (
+        commands,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_HOST_BIT | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+        0, 0, nullptr, 1, &toHost, 1, &toPresent
+    );
+
+    slot.pending = true;
+    slot.index = m_frame++;
+    slot.width = frame.extent.width;
+    slot.height = frame.extent.height;
+    slot.frameSlot = frame.slot;
+
+    m_next = (m_next + 1) % m_slotsCount;
+}
+#endif
+
+/* ####################################################################################### */
+/* Getters */
+/* ####################################################################################### */
+
+CaptureStats
+FrameCapture::stats() const
+{
+    CaptureStats result;
+    result.captured = m_captured;
+    result.dropped = m_dropped;
+    result.written = m_writer->written();
+    result.failed = m_writer->failed();
+
+    return result;
+}
+
+/* ####################################################################################### */
+/* Internals */
+/* ####################################################################################### */
+
+void
+FrameCapture::submit(Slot& slot)
+{
+    slot.pending = false;
+
+    CaptureFrame frame;
+    frame.pixels = slot.mapped;
+    frame.width = slot.width;
+    frame.height = slot.height;
+    frame.index = slot.index;
+    frame.flipped = m_flipped;
+    frame.bgra = slot.bgra;
+    frame.busy = &slot.busy;
+
+    slot.busy.store(true, std::memory_order_relaxed);
+
+    if (!m_writer->submit(frame))
+    {
+        slot.busy.store(false, std::memory_order_relaxed);
+        m_dropped++;
+        return;
+    }
+
+    m_captured++;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+bool
+FrameCapture::reserve(Slot& slot, std::uint64_t size)
+{
+    if (slot.mapped && slot.size == size)
+    {
+        return true;
+    }
+
+    release(slot);
+
+#ifdef EZWINDOW_OPENGL
+    const GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glCreateBuffers(1, &slot.buffer);
+    glNamedBufferStorage(slot.buffer, GLsizeiptr(size), nullptr, flags);
+
+    slot.mapped = static_cast<unsigned char*>(glMapNamedBufferRange(slot.buffer, 0, GLsizeiptr(size), flags));
+
+    if (!slot.mapped)
+    {
+        EZWINDOW_ERROR("Cant map capture buffer, OpenGL 4.4 or ARB_buffer_storage is required");
+        release(slot);
+        return false;
+    }
+#endif
+
+#ifdef EZWINDOW_VULKAN
+    const VulkanSwapchainConfig& config = m_swapchain->config();
+
+    VkBufferCreateInfo bufferInfo {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(config.device, &bufferInfo, config.allocator, &slot.buffer) != VK_SUCCESS)
+    {
+        EZWINDOW_ERROR("Cant create capture buffer");
+        slot.buffer = VK_NULL_HANDLE;
+        return false;
+    }
+
+    VkMemoryRequirements requirements {};
+    vkGetBufferMemoryRequirements(config.device, slot.buffer, &requirements);
+
+    VkMemoryAllocateInfo memoryInfo {};
+    memoryInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    memoryInfo.allocationSize = requirements.size;
+    memoryInfo.memoryTypeIndex = findMemoryType(m_memory, requirements.memoryTypeBits);
+
+    void* mapped = nullptr;
+
+    if (memoryInfo.memoryTypeIndex == VK_MAX_MEMORY_TYPES ||
+        vkAllocateMemory(config.device, &memoryInfo, config.allocator, &slot.memory) != VK_SUCCESS ||
+        vkBindBufferMemory(config.device, slot.buffer, slot.memory, 0) != VK_SUCCESS ||
+        vkMapMemory(config.device, slot.memory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS)
+    {
+        EZWINDOW_ERROR("Cant allocate host visible capture memory");
+        release(slot);
+        return false;
+    }
+
+    slot.mapped = static_cast<unsigned char*>(mapped);
+#endif
+
+    slot.size = size;
+
+    return true;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+FrameCapture::release(Slot& slot)
+{
+#ifdef EZWINDOW_OPENGL
+    if (slot.fence)
+    {
+        glDeleteSync(GLsync(slot.fence));
+        slot.fence = nullptr;
+    }
+
+    if (slot.buffer)
+    {
+        if (slot.mapped)
+        {
+            glUnmapNamedBuffer(slot.buffer);
+        }
+        glDeleteBuffers(1, &slot.buffer);
+        slot.buffer = 0;
+    }
+#endif
+
+#ifdef EZWINDOW_VULKAN
+    const VulkanSwapchainConfig& config = m_swapchain->config();
+
+    if (slot.memory)
+    {
+        if (slot.mapped)
+        {
+            vkUnmapMemory(config.device, slot.memory);
+        }
+        vkFreeMemory(config.device, slot.memory, config.allocator);
+        slot.memory = VK_NULL_HANDLE;
+    }
+
+    if (slot.buffer)
+    {
+        vkDestroyBuffer(config.device, slot.buffer, config.allocator);
+        slot.buffer = VK_NULL_HANDLE;
+    }
+#endif
+
+    slot.mapped = nullptr;
+    slot.size = 0;
+    slot.pending = false;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+#ifdef EZWINDOW_OPENGL
+void
+FrameCapture::collect(bool all)
+{
+    // Readbacks finish in order, the first unfinished one ends collection
+    while (m_slots[m_head].pending)
+    {
+        Slot& slot = m_slots[m_head];
+        GLenum result = glClientWaitSync(GLsync(slot.fence), GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+
+        while (all && result == GL_TIMEOUT_EXPIRED)
+        {
+            result = glClientWaitSync(GLsync(slot.fence), GL_SYNC_FLUSH_COMMANDS_BIT, WaitTimeout);
+        }
+
+        if (result == GL_TIMEOUT_EXPIRED)
+        {
+            return;
+        }
+
+        glDeleteSync(GLsync(slot.fence));
+        slot.fence = nullptr;
+
+        if (result == GL_WAIT_FAILED)
+        {
+            EZWINDOW_WARNING("Capture fence wait failed");
+            slot.pending = false;
+            m_dropped++;
+        }
+        else
+        {
+            submit(slot);
+        }
+
+        m_head = (m_head + 1) % m_slotsCount;
+    }
+}
+#endif
+
+/* --------------------------------------------------------------------------------------- */
+
+#ifdef EZWINDOW_VULKAN
+void
+FrameCapture::collect(std::uint32_t frameSlot)
+{
+    // Acquire waited fence of frame slot, so its copies and all older ones are done
+    std::uint32_t count = 0;
+
+    for (std::uint32_t i = 0; i < m_slotsCount; ++i)
+    {
+        const Slot& slot = m_slots[(m_head + i) % m_slotsCount];
+
+        if (!slot.pending)
+        {
+            break;
+        }
+
+        if (slot.frameSlot == frameSlot)
+        {
+            count = i + 1;
+        }
+    }
+
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        submit(m_slots[m_head]);
+        m_head = (m_head + 1) % m_slotsCount;
+    }
+}
+#endif
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include <EasyWindow/FrameClock.hpp>
+
+#include <algorithm>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/* ####################################################################################### */
+/* Methods */
+/* ####################################################################################### */
+
+void
+FrameClock::reset(std::uint64_t now)
+{
+    m_origin = now;
+    m_time = 0;
+    m_delta = 0;
+    m_ticked = false;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+FrameClock::tick(std::uint64_t now)
+{
+    // Steady clock never goes back, guard against origin set from another clock anyway
+    const std::uint64_t time = now > m_origin ? now - m_origin : 0;
+
+    m_delta = std::max(time, m_time) - m_time;
+    m_time = std::max(time, m_time);
+    m_frame++;
+
+    if (m_ticked)
+    {
+        record(m_delta);
+    }
+
+    m_ticked = true;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+FrameClock::step(std::uint64_t delta)
+{
+    m_delta = delta;
+    m_time += delta;
+    m_frame++;
+    m_ticked = true;
+
+    record(delta);
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+FrameClock::setSmoothing(double factor)
+{
+    m_smoothing = std::clamp(factor, 1e-6, 1.0);
+}
+
+/* ####################################################################################### */
+/* Getters */
+/* ####################################################################################### */
+
+FrameTimeSummary
+FrameClock::summary() const
+{
+    FrameTimeSummary result;
+
+    if (m_count > 0)
+    {
+        result.min = m_min.items[m_min.head].value;
+        result.max = m_max.items[m_max.head].value;
+        result.average = double(m_sum) / double(m_count);
+        result.smoothed = m_smoothed;
+    }
+
+    return result;
+}
+
+/* ####################################################################################### */
+/* Internals */
+/* ####################################################################################### */
+
+template<typename Compare>
+void
+FrameClock::ExtremeQueue::push(std::uint64_t frame, std::uint64_t value, Compare dominates)
+{
+    // Drop values which left history
+    while (count > 0 && items[head].frame + HistorySize <= frame)
+    {
+        head = (head + 1) % HistorySize;
+        count--;
+    }
+
+    // Drop values the new one outlives and dominates, queue stays sorted
+    while (count > 0 && !dominates(items[(head + count - 1) % HistorySize].value, value))
+    {
+        count--;
+    }
+
+    items[(head + count) % HistorySize] = {frame, value};
+    count++;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+FrameClock::record(std::uint64_t delta)
+{
+    const std::size_t index = m_written % HistorySize;
+
+    if (m_count == HistorySize)
+    {
+        m_sum -= m_history[index];
+    }
+    else
+    {
+        m_count++;
+    }
+
+    m_history[index] = delta;
+    m_history[index + HistorySize] = delta;
+    m_sum += delta;
+
+    m_min.push(m_written, delta, [](std::uint64_t kept, std::uint64_t value){ return kept < value; });
+    m_max.push(m_written, delta, [](std::uint64_t kept, std::uint64_t value){ return kept > value; });
+
+    m_smoothed = m_written == 0 ? double(delta) : m_smoothed + m_smoothing * (double(delta) - m_smoothed);
+    m_written++;
+}
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include <EasyWindow/FramePacer.hpp>
+
+#include <thread>
+#include <algorithm>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+namespace
+{
+    constexpr std::chrono::microseconds
+    MinSpinThreshold {200};
+
+    constexpr std::chrono::microseconds
+    MaxSpinThreshold {4000};
+}
+
+/* ####################################################################################### */
+/* Methods */
+/* ####################################################################################### */
+
+void
+FramePacer::setTargetRate(double rate)
+{
+    m_rate = rate > 0.0 ? rate : 0.0;
+
+    if (m_rate > 0.0)
+    {
+        m_period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_rate));
+    }
+    else
+    {
+        m_period = Clock::duration::zero();
+    }
+
+    reset();
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+FramePacer::reset()
+{
+    m_deadline = Clock::now() + m_period;
+    m_lastWait = 0.0;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+double
+FramePacer::wait()
+{
+    m_lastWait = 0.0;
+
+    if (m_period == Clock::duration::zero())
+    {
+        return m_lastWait;
+    }
+
+    const auto start = Clock::now();
+
+    if (start >= m_deadline)
+    {
+        // Frame missed its deadline. If it missed by more than one period there is
+        // no point to catch up with a burst of unpaced frames, so start over.
+        m_deadline = start - m_deadline > m_period ? start + m_period : m_deadline + m_period;
+        return m_lastWait;
+    }
+
+    auto now = start;
+
+    // Sleep phase. Threshold follows the observed sleep overshoot, so the sleep
+    // always wakes up before the deadline and the rest is done by spinning.
+    while (m_deadline - now > m_spinThreshold)
+    {
+        const auto request = m_deadline - now - m_spinThreshold;
+        std::this_thread::sleep_for(request);
+
+        const auto after = Clock::now();
+        const auto overshoot = (after - now) - request;
+        const auto target = std::clamp<Clock::duration>(overshoot * 2, MinSpinThreshold, MaxSpinThreshold);
+
+        if (target > m_spinThreshold)
+        {
+            m_spinThreshold = target;
+        }
+        else
+        {
+            m_spinThreshold -= (m_spinThreshold - target) / 8;
+        }
+
+        now = after;
+    }
+
+    // Spin phase
+    while (now < m_deadline)
+    {
+        now = Clock::now();
+    }
+
+    m_lastWait = std::chrono::duration<double>(now - start).count();
+    m_deadline += m_period;
+
+    return m_lastWait;
+}
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
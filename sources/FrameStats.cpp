@@ -0,0 +1,223 @@
+#include <EasyWindow/FrameStats.hpp>
+
+#include <cmath>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/* ####################################################################################### */
+/* Histogram */
+/* ####################################################################################### */
+
+std::uint64_t
+Histogram::percentile(double quantile) const
+{
+    if (m_count == 0)
+    {
+        return 0;
+    }
+
+    const double clamped = quantile < 0.0 ? 0.0 : quantile > 1.0 ? 1.0 : quantile;
+    const auto target = std::max<std::uint64_t>(1, std::uint64_t(std::ceil(clamped * double(m_count))));
+
+    std::uint64_t accumulated = 0;
+
+    for (std::uint32_t i = 0; i < BucketsCount; ++i)
+    {
+        accumulated += m_buckets[i];
+
+        if (accumulated >= target)
+        {
+            const auto bound = bucketUpperBound(i);
+            return bound < m_max ? bound : m_max;
+        }
+    }
+
+    return m_max;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Histogram::reset()
+{
+    m_buckets.fill(0);
+    m_count = 0;
+    m_sum = 0;
+    m_max = 0;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+std::uint32_t
+Histogram::bucket(std::uint64_t value)
+{
+    if (value < SubBuckets)
+    {
+        return std::uint32_t(value);
+    }
+
+    std::uint32_t exponent = 63;
+    while (!(value >> exponent))
+    {
+        --exponent;
+    }
+
+    if (exponent > MaxExponent)
+    {
+        return BucketsCount - 1;
+    }
+
+    const auto group = exponent - SubBucketBits + 1;
+    const auto sub = std::uint32_t(value >> (exponent - SubBucketBits)) & (SubBuckets - 1);
+
+    return group * SubBuckets + sub;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+std::uint64_t
+Histogram::bucketUpperBound(std::uint32_t index)
+{
+    const auto group = index / SubBuckets;
+    const auto sub = index % SubBuckets;
+
+    if (group == 0)
+    {
+        return sub;
+    }
+
+    const auto shift = group - 1;
+    const auto lower = std::uint64_t(SubBuckets + sub) << shift;
+
+    return lower + (std::uint64_t(1) << shift) - 1;
+}
+
+/* ####################################################################################### */
+/* FrameStats */
+/* ####################################################################################### */
+
+PhaseSummary
+FrameStats::summary(EFramePhase phase) const
+{
+    const auto& histogram = m_phases[std::size_t(phase)];
+
+    PhaseSummary result {};
+    result.count = histogram.count();
+    result.p50 = histogram.percentile(0.50);
+    result.p95 = histogram.percentile(0.95);
+    result.p99 = histogram.percentile(0.99);
+    result.max = histogram.max();
+    result.mean = histogram.mean();
+
+    return result;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+FrameStats::reset()
+{
+    for (auto& histogram : m_phases)
+    {
+        histogram.reset();
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+std::string
+FrameStats::toCsv() const
+{
+    std::ostringstream stream;
+    stream << "phase,count,mean_ns,p50_ns,p95_ns,p99_ns,max_ns\n";
+
+    for (std::size_t i = 0; i < m_phases.size(); ++i)
+    {
+        const auto phase = EFramePhase(i);
+        const auto s = summary(phase);
+
+        stream
+            << phaseName(phase) << ','
+            << s.count << ','
+            << std::uint64_t(s.mean) << ','
+            << s.p50 << ','
+            << s.p95 << ','
+            << s.p99 << ','
+            << s.max << '\n';
+    }
+
+    return stream.str();
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+std::string
+FrameStats::toJson() const
+{
+    std::ostringstream stream;
+    stream << "{";
+
+    for (std::size_t i = 0; i < m_phases.size(); ++i)
+    {
+        const auto phase = EFramePhase(i);
+        const auto s = summary(phase);
+
+        stream
+            << (i ? "," : "")
+            << "\"" << phaseName(phase) << "\":{"
+            << "\"count\":" << s.count << ","
+            << "\"mean_ns\":" << std::uint64_t(s.mean) << ","
+            << "\"p50_ns\":" << s.p50 << ","
+            << "\"p95_ns\":" << s.p95 << ","
+            << "\"p99_ns\":" << s.p99 << ","
+            << "\"max_ns\":" << s.max << "}";
+    }
+
+    stream << "}";
+
+    return stream.str();
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+bool
+FrameStats::write(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+    if (!file)
+    {
+        return false;
+    }
+
+    const bool csv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+    file << (csv ? toCsv() : toJson());
+
+    return bool(file);
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+const char*
+FrameStats::phaseName(EFramePhase phase)
+{
+    switch (phase)
+    {
+        case EFramePhase::Poll:     return "poll";
+        case EFramePhase::Dispatch: return "dispatch";
+        case EFramePhase::Tick:     return "tick";
+        case EFramePhase::Clear:    return "clear";
+        case EFramePhase::Render:   return "render";
+        case EFramePhase::Swap:     return "swap";
+        case EFramePhase::Wait:     return "wait";
+        case EFramePhase::Count:    break;
+    }
+
+    return "unknown";
+}
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
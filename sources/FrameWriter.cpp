@@ -0,0 +1,546 @@
+#include <EasyWindow/FrameWriter.hpp>
+#include <EasyWindow/Logger.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define EZWINDOW_SSE2
+#endif
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+namespace
+{
+    /** Writer checks for new frames this often even if nobody notifies it */
+    constexpr std::chrono::milliseconds
+    WakeInterval {5};
+
+    /** Max data of one stored deflate block */
+    constexpr std::size_t
+    StoredBlockSize = 65535;
+
+    /* ----------------------------------------------------------------------------------- */
+
+    // BT.601 full range (JPEG) coefficients, 8 bit fixed point
+    int
+    clampByte(int value)
+    {
+        return value < 0 ? 0 : value > 255 ? 255 : value;
+    }
+
+    unsigned char
+    lumaOf(int r, int g, int b)
+    {
+        return static_cast<unsigned char>((77 * r + 150 * g + 29 * b + 128) >> 8);
+    }
+
+    unsigned char
+    cbOf(int r, int g, int b)
+    {
+        return static_cast<unsigned char>(clampByte(((-43 * r - 85 * g + 128 * b + 128) >> 8) + 128));
+    }
+
+    unsigned char
+    crOf(int r, int g, int b)
+    {
+        return static_cast<unsigned char>(clampByte(((128 * r - 107 * g - 21 * b + 128) >> 8) + 128));
+    }
+
+#ifdef EZWINDOW_SSE2
+    /** Channel of 8 pixels (two registers of 4) as 16 bit lanes */
+    __m128i
+    channel16(__m128i first, __m128i second, int shift)
+    {
+        const __m128i mask = _mm_set1_epi32(0xFF);
+
+        return _mm_packs_epi32
+        (
+            _mm_and_si128(_mm_srli_epi32(first, shift), mask),
+            _mm_and_si128(_mm_srli_epi32(second, shift), mask)
+        );
+    }
+
+    /** Average of horizontal pairs of 16 bit sums of two rows, as 32 bit lanes */
+    __m128i
+    average2x2(__m128i rowsSum)
+    {
+        const __m128i pairs = _mm_madd_epi16(rowsSum, _mm_set1_epi16(1));
+        return _mm_srli_epi32(_mm_add_epi32(pairs, _mm_set1_epi32(2)), 2);
+    }
+
+    /** ((a * r + b * g + c * x + d) >> 8) + 128 of 4 lanes, saturated to bytes */
+    int
+    chroma4(__m128i r, __m128i g, __m128i x, int a, int b, int c)
+    {
+        // Interleave 16 bit pairs (r, g) and (x, 1) to use multiply-add
+        const __m128i rg = _mm_or_si128(r, _mm_slli_epi32(g, 16));
+        const __m128i x1 = _mm_or_si128(x, _mm_set1_epi32(1 << 16));
+
+        const __m128i sum = _mm_add_epi32
+        (
+            _mm_madd_epi16(rg, _mm_set1_epi32(int((std::uint32_t(b) << 16) | (std::uint32_t(a) & 0xFFFF)))),
+            _mm_madd_epi16(x1, _mm_set1_epi32(int((128u << 16) | (std::uint32_t(c) & 0xFFFF))))
+        );
+
+        const __m128i value = _mm_add_epi32(_mm_srai_epi32(sum, 8), _mm_set1_epi32(128));
+        const __m128i words = _mm_packs_epi32(value, value);
+
+        return _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+    }
+#endif
+
+    /* ----------------------------------------------------------------------------------- */
+
+    const std::array<std::uint32_t, 256>&
+    crcTable()
+    {
+        static const std::array<std::uint32_t, 256> table = []
+        {
+            std::array<std::uint32_t, 256> result {};
+
+            for (std::uint32_t i = 0; i < 256; ++i)
+            {
+                std::uint32_t value = i;
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    value = value & 1 ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+                }
+                result[i] = value;
+            }
+
+            return result;
+        }();
+
+        return table;
+    }
+
+    std::uint32_t
+    crc32(std::uint32_t crc, const unsigned char* data, std::size_t size)
+    {
+        const auto& table = crcTable();
+
+        crc = ~crc;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+
+        return ~crc;
+    }
+
+    void
+    appendBigEndian(std::vector<unsigned char>& out, std::uint32_t value)
+    {
+        out.push_back(static_cast<unsigned char>(value >> 24));
+        out.push_back(static_cast<unsigned char>(value >> 16));
+        out.push_back(static_cast<unsigned char>(value >> 8));
+        out.push_back(static_cast<unsigned char>(value));
+    }
+
+    bool
+    writeChunk(std::FILE* file, const char* type, const unsigned char* data, std::size_t size)
+    {
+        std::vector<unsigned char> header;
+        appendBigEndian(header, std::uint32_t(size));
+        header.insert(header.end(), type, type + 4);
+
+        std::uint32_t crc = crc32(0, header.data() + 4, 4);
+        crc = crc32(crc, data, size);
+
+        std::vector<unsigned char> footer;
+        appendBigEndian(footer, crc);
+
+        return std::fwrite(header.data(), 1, header.size(), file) == header.size() &&
+               (size == 0 || std::fwrite(data, 1, size, file) == size) &&
+               std::fwrite(footer.data(), 1, footer.size(), file) == footer.size();
+    }
+}
+
+/* ####################################################################################### */
+/* Constructors */
+/* ####################################################################################### */
+
+FrameWriter::~FrameWriter()
+{
+    m_stop.store(true, std::memory_order_release);
+    m_wake.notify_one();
+    m_thread.join();
+
+    if (m_file)
+    {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+FrameWriter::FrameWriter(const std::string& path, ECaptureFormat format, double frameRate)
+    : m_path(path)
+    , m_format(format)
+    , m_frameRate(frameRate > 0.0 ? frameRate : 60.0)
+{
+    if (m_format != ECaptureFormat::Png)
+    {
+        m_file = std::fopen(m_path.c_str(), "wb");
+
+        if (!m_file)
+        {
+            EZWINDOW_ERROR("Cant open capture file " << m_path);
+        }
+    }
+
+    m_thread = std::thread([this]{ writerLoop(); });
+}
+
+/* ####################################################################################### */
+/* Methods */
+/* ####################################################################################### */
+
+bool
+FrameWriter::submit(const CaptureFrame& frame)
+{
+    if (!m_queue.push(frame))
+    {
+        return false;
+    }
+
+    // Lost notification only delays writer until its periodic wake up
+    m_wake.notify_one();
+    return true;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+FrameWriter::convertI420(const CaptureFrame& frame, unsigned char* y, unsigned char* u, unsigned char* v)
+{
+    const std::uint32_t width = frame.width;
+    const std::uint32_t height = frame.height;
+    const std::uint32_t chromaWidth = (width + 1) / 2;
+
+    const int r = frame.bgra ? 2 : 0;
+    const int b = frame.bgra ? 0 : 2;
+
+    const auto row = [&frame](std::uint32_t index)
+    {
+        const std::uint32_t stored = frame.flipped ? frame.height - 1 - index : index;
+        return frame.pixels + std::size_t(stored) * frame.width * 4;
+    };
+
+    for (std::uint32_t top = 0; top < height; top += 2)
+    {
+        const std::uint32_t bottom = std::min(top + 1, height - 1);
+        const unsigned char* rows[2] = {row(top), row(bottom)};
+
+        // Luma of both rows (bottom one only if it exists)
+        for (std::uint32_t i = 0; i < (bottom != top ? 2u : 1u); ++i)
+        {
+            const unsigned char* source = rows[i];
+            unsigned char* destination = y + std::size_t(top + i) * width;
+            std::uint32_t x = 0;
+
+#ifdef EZWINDOW_SSE2
+            for (; x + 8 <= width; x += 8)
+            {
+                const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x * 4));
+                const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x * 4 + 16));
+
+                // Sum fits into unsigned 16 bits, wrapping products add up correctly
+                __m128i luma = _mm_mullo_epi16(channel16(first, second, r * 8), _mm_set1_epi16(77));
+                luma = _mm_add_epi16(luma, _mm_mullo_epi16(channel16(first, second, 8), _mm_set1_epi16(150)));
+                luma = _mm_add_epi16(luma, _mm_mullo_epi16(channel16(first, second, b * 8), _mm_set1_epi16(29)));
+                luma = _mm_srli_epi16(_mm_add_epi16(luma, _mm_set1_epi16(128)), 8);
+
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(destination + x), _mm_packus_epi16(luma, luma));
+            }
+#endif
+            for (; x < width; ++x)
+            {
+                const unsigned char* pixel = source + x * 4;
+                destination[x] = lumaOf(pixel[r], pixel[1], pixel[b]);
+            }
+        }
+
+        // Chroma of 2x2 blocks
+        unsigned char* cb = u + std::size_t(top / 2) * chromaWidth;
+        unsigned char* cr = v + std::size_t(top / 2) * chromaWidth;
+        std::uint32_t x = 0;
+
+#ifdef EZWINDOW_SSE2
+        for (; x + 8 <= width; x += 8)
+        {
+            const __m128i top0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[0] + x * 4));
+            const __m128i top1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[0] + x * 4 + 16));
+            const __m128i bottom0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[1] + x * 4));
+            const __m128i bottom1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[1] + x * 4 + 16));
+
+            const __m128i red = average2x2(_mm_add_epi16(channel16(top0, top1, r * 8), channel16(bottom0, bottom1, r * 8)));
+            const __m128i green = average2x2(_mm_add_epi16(channel16(top0, top1, 8), channel16(bottom0, bottom1, 8)));
+            const __m128i blue = average2x2(_mm_add_epi16(channel16(top0, top1, b * 8), channel16(bottom0, bottom1, b * 8)));
+
+            const int cbValues = chroma4(red, green, blue, -43, -85, 128);
+            const int crValues = chroma4(red, green, blue, 128, -107, -21);
+
+            std::memcpy(cb + x / 2, &cbValues, 4);
+            std::memcpy(cr + x / 2, &crValues, 4);
+        }
+#endif
+        for (; x < width; x += 2)
+        {
+            const std::uint32_t right = std::min(x + 1, width - 1);
+            const unsigned char* p[4] = {rows[0] + x * 4, rows[0] + right * 4, rows[1] + x * 4, rows[1] + right * 4};
+
+            const int red = (p[0][r] + p[1][r] + p[2][r] + p[3][r] + 2) >> 2;
+            const int green = (p[0][1] + p[1][1] + p[2][1] + p[3][1] + 2) >> 2;
+            const int blue = (p[0][b] + p[1][b] + p[2][b] + p[3][b] + 2) >> 2;
+
+            cb[x / 2] = cbOf(red, green, blue);
+            cr[x / 2] = crOf(red, green, blue);
+        }
+    }
+}
+
+/* ####################################################################################### */
+/* Internals */
+/* ####################################################################################### */
+
+void
+FrameWriter::writerLoop()
+{
+    for (;;)
+    {
+        CaptureFrame frame;
+
+        if (m_queue.pop(frame))
+        {
+            if (write(frame))
+            {
+                m_written.fetch_add(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                if (m_failed.load(std::memory_order_relaxed) == 0)
+                {
+                    EZWINDOW_WARNING("Cant write captured frame " << frame.index << " to " << m_path);
+                }
+                m_failed.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            // Readback memory can be reused
+            frame.busy->store(false, std::memory_order_release);
+            continue;
+        }
+
+        if (m_stop.load(std::memory_order_acquire))
+        {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wake.wait_for(lock, WakeInterval, [this]
+        {
+            return !m_queue.empty() || m_stop.load(std::memory_order_acquire);
+        });
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+bool
+FrameWriter::write(const CaptureFrame& frame)
+{
+    if (m_format == ECaptureFormat::Png)
+    {
+        return writePng(frame);
+    }
+
+    if (!m_file)
+    {
+        return false;
+    }
+
+    // Stream formats keep size of the first frame
+    if (m_width == 0)
+    {
+        m_width = frame.width;
+        m_height = frame.height;
+
+        if (m_format == ECaptureFormat::Y4M)
+        {
+            const auto rate = std::uint64_t(m_frameRate * 1000.0 + 0.5);
+
+            // Planes are full range, players assume limited range without the tag
+            std::fprintf(m_file, "YUV4MPEG2 W%u H%u F%llu:1000 Ip A1:1 C420jpeg XCOLORRANGE=FULL\n", m_width, m_height, static_cast<unsigned long long>(rate));
+        }
+    }
+
+    if (frame.width != m_width || frame.height != m_height)
+    {
+        return false;
+    }
+
+    return m_format == ECaptureFormat::Y4M ? writeY4M(frame) : writeRaw(frame);
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+bool
+FrameWriter::writeRaw(const CaptureFrame& frame)
+{
+    const std::size_t rowSize = std::size_t(frame.width) * 4;
+
+    if (!frame.flipped && !frame.bgra)
+    {
+        const std::size_t size = rowSize * frame.height;
+        return std::fwrite(frame.pixels, 1, size, m_file) == size;
+    }
+
+    m_buffer.resize(rowSize);
+
+    for (std::uint32_t y = 0; y < frame.height; ++y)
+    {
+        copyRow(frame, y, m_buffer.data());
+
+        if (std::fwrite(m_buffer.data(), 1, rowSize, m_file) != rowSize)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+bool
+FrameWriter::writeY4M(const CaptureFrame& frame)
+{
+    const std::size_t lumaSize = std::size_t(frame.width) * frame.height;
+    const std::size_t chromaSize = std::size_t((frame.width + 1) / 2) * ((frame.height + 1) / 2);
+
+    m_buffer.resize(lumaSize + chromaSize * 2);
+
+    unsigned char* y = m_buffer.data();
+    unsigned char* u = y + lumaSize;
+    unsigned char* v = u + chromaSize;
+
+    convertI420(frame, y, u, v);
+
+    static const char FrameHeader[] = "FRAME\n";
+
+    return std::fwrite(FrameHeader, 1, sizeof(FrameHeader) - 1, m_file) == sizeof(FrameHeader) - 1 &&
+           std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file) == m_buffer.size();
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+bool
+FrameWriter::writePng(const CaptureFrame& frame)
+{
+    char index[32];
+    std::snprintf(index, sizeof(index), "_%06llu.png", static_cast<unsigned long long>(frame.index));
+
+    std::FILE* file = std::fopen((m_path + index).c_str(), "wb");
+
+    if (!file)
+    {
+        return false;
+    }
+
+    const std::size_t rowSize = std::size_t(frame.width) * 4;
+    const std::size_t rawSize = (rowSize + 1) * frame.height;
+
+    // Scanlines with filter type 0 wrapped into zlib stream of stored deflate blocks,
+    // compressing on this thread would fall behind the render loop
+    m_buffer.clear();
+    m_buffer.reserve(2 + rawSize + (rawSize / StoredBlockSize + 1) * 5 + 4);
+    m_buffer.push_back(0x78);
+    m_buffer.push_back(0x01);
+
+    std::vector<unsigned char> row(rowSize + 1, 0);
+    std::size_t blockLeft = 0;
+    std::uint32_t adlerA = 1;
+    std::uint32_t adlerB = 0;
+    std::size_t written = 0;
+
+    for (std::uint32_t y = 0; y < frame.height; ++y)
+    {
+        copyRow(frame, y, row.data() + 1);
+
+        for (std::size_t offset = 0; offset < row.size();)
+        {
+            if (blockLeft == 0)
+            {
+                blockLeft = std::min(StoredBlockSize, rawSize - written);
+                const auto length = std::uint16_t(blockLeft);
+
+                m_buffer.push_back(written + blockLeft == rawSize ? 1 : 0);
+                m_buffer.push_back(static_cast<unsigned char>(length));
+                m_buffer.push_back(static_cast<unsigned char>(length >> 8));
+                m_buffer.push_back(static_cast<unsigned char>(~length));
+                m_buffer.push_back(static_cast<unsigned char>(~length >> 8));
+            }
+
+            const std::size_t count = std::min(blockLeft, row.size() - offset);
+            m_buffer.insert(m_buffer.end(), row.begin() + std::ptrdiff_t(offset), row.begin() + std::ptrdiff_t(offset + count));
+
+            for (std::size_t i = offset; i < offset + count; ++i)
+            {
+                adlerA = (adlerA + row[i]) % 65521;
+                adlerB = (adlerB + adlerA) % 65521;
+            }
+
+            offset += count;
+            written += count;
+            blockLeft -= count;
+        }
+    }
+
+    appendBigEndian(m_buffer, (adlerB << 16) | adlerA);
+
+    static const unsigned char Signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+    std::vector<unsigned char> header;
+    appendBigEndian(header, frame.width);
+    appendBigEndian(header, frame.height);
+    header.insert(header.end(), {8, 6, 0, 0, 0});   // 8 bit RGBA, deflate, no interlace
+
+    const bool result =
+        std::fwrite(Signature, 1, sizeof(Signature), file) == sizeof(Signature) &&
+        writeChunk(file, "IHDR", header.data(), header.size()) &&
+        writeChunk(file, "IDAT", m_buffer.data(), m_buffer.size()) &&
+        writeChunk(file, "IEND", nullptr, 0);
+
+    return std::fclose(file) == 0 && result;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+FrameWriter::copyRow(const CaptureFrame& frame, std::uint32_t row, unsigned char* destination) const
+{
+    const std::uint32_t stored = frame.flipped ? frame.height - 1 - row : row;
+    const unsigned char* source = frame.pixels + std::size_t(stored) * frame.width * 4;
+
+    if (!frame.bgra)
+    {
+        std::memcpy(destination, source, std::size_t(frame.width) * 4);
+        return;
+    }
+
+    for (std::uint32_t x = 0; x < frame.width; ++x)
+    {
+        destination[x * 4 + 0] = source[x * 4 + 2];
+        destination[x * 4 + 1] = source[x * 4 + 1];
+        destination[x * 4 + 2] = source[x * 4 + 0];
+        destination[x * 4 + 3] = source[x * 4 + 3];
+    }
+}
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include <EasyWindow/GLStreamBuffer.hpp>
+#include <EasyWindow/Logger.hpp>
+
+#ifdef EZWINDOW_OPENGL
+
+#include <GL/glew.h>
+
+#include <cstring>
+#include <algorithm>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+namespace
+{
+    /** Wait timeout per glClientWaitSync call (in nanoseconds) */
+    constexpr GLuint64
+    WaitTimeout = 1000000000;
+}
+
+/* ####################################################################################### */
+/* Constructors */
+/* ####################################################################################### */
+
+GLStreamBuffer::~GLStreamBuffer()
+{
+    for (auto& fence : m_fences)
+    {
+        if (fence)
+        {
+            glDeleteSync(GLsync(fence));
+            fence = nullptr;
+        }
+    }
+
+    if (m_buffer)
+    {
+        // Persistent mapping is allowed to stay while buffer is deleted, unmap anyway
+        glUnmapNamedBuffer(m_buffer);
+        glDeleteBuffers(1, &m_buffer);
+        m_buffer = 0;
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+GLStreamBuffer::GLStreamBuffer(std::uint64_t frameSize, std::uint32_t framesCount)
+    : m_frameSize(frameSize)
+    , m_fences(std::max(framesCount, 1u), nullptr)
+{
+    const GLsizeiptr size = GLsizeiptr(m_frameSize * m_fences.size());
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glCreateBuffers(1, &m_buffer);
+    glNamedBufferStorage(m_buffer, size, nullptr, flags);
+
+    m_mapped = static_cast<unsigned char*>(glMapNamedBufferRange(m_buffer, 0, size, flags));
+
+    if (!m_mapped)
+    {
+        EZWINDOW_ERROR("Cant map stream buffer, OpenGL 4.4 or ARB_buffer_storage is required");
+        m_frameSize = 0;
+    }
+}
+
+/* ####################################################################################### */
+/* Methods */
+/* ####################################################################################### */
+
+StreamAllocation
+GLStreamBuffer::allocate(std::uint64_t size, std::uint64_t alignment)
+{
+    // Offset rounding needs power of two, others are rounded up to one
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+    {
+        std::uint64_t rounded = 1;
+        while (rounded < alignment)
+        {
+            rounded <<= 1;
+        }
+        alignment = rounded;
+    }
+
+    const std::uint64_t begin = m_region * m_frameSize;
+    const std::uint64_t offset = (begin + m_head + alignment - 1) & ~(alignment - 1);
+
+    if (offset + size > begin + m_frameSize)
+    {
+        m_stats.failedAllocations++;
+        return {};
+    }
+
+    m_stats.allocations++;
+    m_stats.allocatedBytes += offset + size - (begin + m_head);
+
+    m_head = offset + size - begin;
+    m_stats.peakFrameBytes = std::max(m_stats.peakFrameBytes, m_head);
+
+    return {m_mapped + offset, offset, size};
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+StreamAllocation
+GLStreamBuffer::upload(const void* data, std::uint64_t size, std::uint64_t alignment)
+{
+    StreamAllocation allocation = allocate(size, alignment);
+
+    // Coherent mapping, writes are visible to commands issued after this call
+    if (allocation.data)
+    {
+        std::memcpy(allocation.data, data, size);
+    }
+
+    return allocation;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+GLStreamBuffer::endFrame()
+{
+    // Unused region needs no fence, it can be reused at once
+    if (m_head > 0)
+    {
+        m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    m_region = (m_region + 1) % std::uint32_t(m_fences.size());
+    m_head = 0;
+
+    GLsync fence = GLsync(m_fences[m_region]);
+
+    if (!fence)
+    {
+        return;
+    }
+
+    GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+
+    if (result == GL_TIMEOUT_EXPIRED)
+    {
+        const auto start = nowNanoseconds();
+
+        while (result == GL_TIMEOUT_EXPIRED)
+        {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, WaitTimeout);
+        }
+
+        m_stats.stalls++;
+        m_stats.stallTime += double(nowNanoseconds() - start) * 1e-9;
+    }
+
+    if (result == GL_WAIT_FAILED)
+    {
+        EZWINDOW_WARNING("Stream buffer fence wait failed");
+    }
+
+    glDeleteSync(fence);
+    m_fences[m_region] = nullptr;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+GLStreamBuffer::resetStats()
+{
+    m_stats = {};
+}
+
+EZWINDOW_NAMESPACE_END
+
+#endif
\ No newline at end of file
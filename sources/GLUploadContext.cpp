@@ -0,0 +1,147 @@
+#include <EasyWindow/GLUploadContext.hpp>
+#include <EasyWindow/Logger.hpp>
+
+#ifdef EZWINDOW_OPENGL
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <iterator>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/* ####################################################################################### */
+/* Constructors */
+/* ####################################################################################### */
+
+GLUploadContext::~GLUploadContext()
+{
+    // Sync objects belong to share group, any context of it can delete them
+    for (const auto& upload : m_pending)
+    {
+        glDeleteSync(GLsync(upload.fence));
+    }
+
+    if (m_window)
+    {
+        glfwDestroyWindow(m_window);
+        m_window = nullptr;
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+GLUploadContext::GLUploadContext(GLFWwindow* share)
+{
+    glfwDefaultWindowHints();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    if (share)
+    {
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, glfwGetWindowAttrib(share, GLFW_CONTEXT_CREATION_API));
+    }
+
+    m_window = glfwCreateWindow(1, 1, "EasyWindow upload", nullptr, share);
+
+    if (!m_window)
+    {
+        EZWINDOW_ERROR("Cant create GLFW upload context");
+    }
+}
+
+/* ####################################################################################### */
+/* Methods */
+/* ####################################################################################### */
+
+void
+GLUploadContext::makeCurrent()
+{
+    glfwMakeContextCurrent(m_window);
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+GLUploadContext::release()
+{
+    glfwMakeContextCurrent(nullptr);
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+GLUploadContext::finish(std::function<void()> ready)
+{
+    GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    // Fence has to reach GPU, render thread polls it without flushing this context
+    glFlush();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.push_back({fence, std::move(ready)});
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+std::size_t
+GLUploadContext::collect()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_pending.empty())
+        {
+            return 0;
+        }
+
+        // Uploads finish in order they were flushed, stop at first unfinished one
+        std::size_t count = 0;
+        for (; count < m_pending.size(); ++count)
+        {
+            const GLenum result = glClientWaitSync(GLsync(m_pending[count].fence), 0, 0);
+
+            if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+            {
+                break;
+            }
+        }
+
+        m_ready.assign
+        (
+            std::make_move_iterator(m_pending.begin()),
+            std::make_move_iterator(m_pending.begin() + std::ptrdiff_t(count))
+        );
+        m_pending.erase(m_pending.begin(), m_pending.begin() + std::ptrdiff_t(count));
+    }
+
+    // Ready functions may start new uploads, they are called without lock
+    for (auto& upload : m_ready)
+    {
+        glDeleteSync(GLsync(upload.fence));
+        upload.ready();
+    }
+
+    const std::size_t count = m_ready.size();
+    m_ready.clear();
+
+    return count;
+}
+
+/* ####################################################################################### */
+/* Getters */
+/* ####################################################################################### */
+
+std::size_t
+GLUploadContext::pending() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pending.size();
+}
+
+EZWINDOW_NAMESPACE_END
+
+#endif
\ No newline at end of file
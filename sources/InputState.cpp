@@ -0,0 +1,87 @@
+#include <EasyWindow/InputState.hpp>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+/* ####################################################################################### */
+/* Modifiers */
+/* ####################################################################################### */
+
+void
+InputState::beginFrame()
+{
+    m_keysPressed.reset();
+    m_keysReleased.reset();
+    m_buttonsPressed.reset();
+    m_buttonsReleased.reset();
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+InputState::setKey(EKey key, EState state)
+{
+    if (!validKey(key))
+    {
+        return;
+    }
+
+    const auto index = std::size_t(key);
+
+    switch (state)
+    {
+        case EState::Press:
+        {
+            m_keysDown[index] = true;
+            m_keysPressed[index] = true;
+            break;
+        }
+        case EState::Release:
+        {
+            m_keysDown[index] = false;
+            m_keysReleased[index] = true;
+            break;
+        }
+        case EState::Repeat:
+        {
+            m_keysDown[index] = true;
+            break;
+        }
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+InputState::setButton(EButton button, EState state)
+{
+    if (!validButton(button))
+    {
+        return;
+    }
+
+    const auto index = std::size_t(button);
+
+    if (state == EState::Release)
+    {
+        m_buttonsDown[index] = false;
+        m_buttonsReleased[index] = true;
+    }
+    else
+    {
+        m_buttonsDown[index] = true;
+        m_buttonsPressed[index] = true;
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+InputState::reset()
+{
+    m_keysDown.reset();
+    m_buttonsDown.reset();
+    beginFrame();
+}
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,448 @@
+#include <EasyWindow/JobSystem.hpp>
+#include <EasyWindow/Trace.hpp>
+#include <EasyWindow/Logger.hpp>
+
+#include <algorithm>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+namespace
+{
+    /** Job system and worker index of current thread, worker 0 for other threads */
+    thread_local const JobSystem*
+    currentSystem = nullptr;
+
+    thread_local std::size_t
+    currentIndex = 0;
+
+    /** Attempts to find a job before worker goes to sleep */
+    constexpr int
+    SpinAttempts = 64;
+}
+
+/* ####################################################################################### */
+/* Constructors */
+/* ####################################################################################### */
+
+JobSystem::~JobSystem()
+{
+    waitAll();
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+JobSystem::JobSystem(std::size_t workersCount)
+{
+    if (workersCount == 0)
+    {
+        const std::size_t hardware = std::thread::hardware_concurrency();
+        workersCount = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    m_chunksStorage.emplace_back(new Job[ChunkSize]);
+    m_chunks[0] = m_chunksStorage.back().get();
+
+    m_workers.reset(new Worker[workersCount + 1]);
+    m_statsStart = nowNanoseconds();
+
+    m_threads.reserve(workersCount);
+    for (std::size_t i = 1; i <= workersCount; ++i)
+    {
+        m_threads.emplace_back([this, i]{ workerLoop(i); });
+    }
+}
+
+/* ####################################################################################### */
+/* Methods */
+/* ####################################################################################### */
+
+JobSystem::JobId
+JobSystem::submit(std::function<void()> job, std::initializer_list<JobId> dependencies, const char* name)
+{
+    return submit(std::move(job), Span<JobId>(dependencies.begin(), dependencies.size()), name);
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+JobSystem::JobId
+JobSystem::submit(std::function<void()> function, Span<JobId> dependencies, const char* name)
+{
+    const JobId id = m_jobsCount.fetch_add(1, std::memory_order_relaxed);
+    const std::uint32_t chunk = id / ChunkSize;
+
+    if (chunk >= MaxChunks)
+    {
+        EZWINDOW_ERROR("Too many jobs in one frame, job is executed at once");
+
+        for (const JobId dependency : dependencies)
+        {
+            wait(dependency);
+        }
+
+        function();
+        return NoJob;
+    }
+
+    if (!m_chunks[chunk].load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lock(m_chunksMutex);
+
+        // Chunks are kept for next frames, so allocation happens only while frames grow
+        if (!m_chunks[chunk].load(std::memory_order_relaxed))
+        {
+            m_chunksStorage.emplace_back(new Job[ChunkSize]);
+            m_chunks[chunk].store(m_chunksStorage.back().get(), std::memory_order_release);
+        }
+    }
+
+    Job& entry = job(id);
+    entry.function = std::move(function);
+    entry.name = name;
+    entry.done.store(false, std::memory_order_relaxed);
+    entry.successors.clear();
+
+    // Extra pending count keeps job from starting while dependencies are registered
+    entry.pending.store(std::uint32_t(dependencies.size()) + 1, std::memory_order_relaxed);
+    m_unfinished.fetch_add(1, std::memory_order_relaxed);
+
+    std::uint32_t finished = 1;
+
+    for (const JobId dependency : dependencies)
+    {
+        if (dependency == NoJob)
+        {
+            ++finished;
+            continue;
+        }
+
+        Job& parent = this->job(dependency);
+        std::lock_guard<std::mutex> lock(parent.mutex);
+
+        if (parent.done.load(std::memory_order_acquire))
+        {
+            ++finished;
+        }
+        else
+        {
+            parent.successors.push_back(id);
+        }
+    }
+
+    if (entry.pending.fetch_sub(finished, std::memory_order_acq_rel) == finished)
+    {
+        schedule(id);
+    }
+
+    return id;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+JobSystem::requireForRender(JobId job)
+{
+    std::lock_guard<std::mutex> lock(m_renderJobsMutex);
+    m_renderJobs.push_back(job);
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+JobSystem::wait(JobId id)
+{
+    const std::size_t worker = currentWorker();
+
+    while (!finished(id))
+    {
+        if (!executeOne(worker))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+JobSystem::waitForRender()
+{
+    std::vector<JobId> jobs;
+    {
+        // Jobs executed while waiting may require more jobs for render
+        std::lock_guard<std::mutex> lock(m_renderJobsMutex);
+        jobs.swap(m_renderJobs);
+    }
+
+    while (!jobs.empty())
+    {
+        for (const JobId id : jobs)
+        {
+            wait(id);
+        }
+
+        jobs.clear();
+
+        std::lock_guard<std::mutex> lock(m_renderJobsMutex);
+        jobs.swap(m_renderJobs);
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+JobSystem::waitAll()
+{
+    const std::size_t worker = currentWorker();
+
+    while (m_unfinished.load(std::memory_order_acquire) > 0)
+    {
+        if (!executeOne(worker))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+JobSystem::beginFrame()
+{
+    waitAll();
+
+    {
+        std::lock_guard<std::mutex> lock(m_renderJobsMutex);
+        m_renderJobs.clear();
+    }
+
+    m_jobsCount.store(0, std::memory_order_relaxed);
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+JobSystem::resetStats()
+{
+    for (std::size_t i = 0; i <= m_threads.size(); ++i)
+    {
+        m_workers[i].jobs.store(0, std::memory_order_relaxed);
+        m_workers[i].busy.store(0, std::memory_order_relaxed);
+    }
+
+    m_statsStart = nowNanoseconds();
+}
+
+/* ####################################################################################### */
+/* Getters */
+/* ####################################################################################### */
+
+bool
+JobSystem::finished(JobId id) const
+{
+    return id == NoJob || job(id).done.load(std::memory_order_acquire);
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+std::vector<WorkerStats>
+JobSystem::workerStats() const
+{
+    const double elapsed = double(nowNanoseconds() - m_statsStart) * 1e-9;
+
+    std::vector<WorkerStats> result(m_threads.size() + 1);
+
+    for (std::size_t i = 0; i < result.size(); ++i)
+    {
+        result[i].jobs = m_workers[i].jobs.load(std::memory_order_relaxed);
+        result[i].busy = double(m_workers[i].busy.load(std::memory_order_relaxed)) * 1e-9;
+        result[i].utilization = elapsed > 0.0 ? std::min(result[i].busy / elapsed, 1.0) : 0.0;
+    }
+
+    return result;
+}
+
+/* ####################################################################################### */
+/* Internals */
+/* ####################################################################################### */
+
+std::size_t
+JobSystem::currentWorker() const
+{
+    return currentSystem == this ? currentIndex : 0;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+JobSystem::schedule(JobId id)
+{
+    Worker& worker = m_workers[currentWorker()];
+
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.queue.push_back(id);
+    }
+
+    m_queued.fetch_add(1, std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wake.notify_one();
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+JobSystem::JobId
+JobSystem::take(std::size_t index)
+{
+    if (m_queued.load(std::memory_order_acquire) == 0)
+    {
+        return NoJob;
+    }
+
+    const std::size_t count = m_threads.size() + 1;
+
+    // Own queue from the back (newest, likely hot in cache), others from the front
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Worker& worker = m_workers[(index + i) % count];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+
+        if (worker.queue.empty())
+        {
+            continue;
+        }
+
+        JobId id = NoJob;
+
+        if (i == 0)
+        {
+            id = worker.queue.back();
+            worker.queue.pop_back();
+        }
+        else
+        {
+            id = worker.queue.front();
+            worker.queue.pop_front();
+        }
+
+        m_queued.fetch_sub(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    return NoJob;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+bool
+JobSystem::executeOne(std::size_t worker)
+{
+    const JobId id = take(worker);
+
+    if (id == NoJob)
+    {
+        return false;
+    }
+
+    execute(id, worker);
+    return true;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+JobSystem::execute(JobId id, std::size_t index)
+{
+    Job& entry = job(id);
+
+    const auto start = nowNanoseconds();
+    entry.function();
+    const auto duration = nowNanoseconds() - start;
+
+    if (Trace::enabled())
+    {
+        Trace::record(entry.name, start, duration);
+    }
+
+    Worker& worker = m_workers[index];
+    worker.jobs.fetch_add(1, std::memory_order_relaxed);
+    worker.busy.fetch_add(duration, std::memory_order_relaxed);
+
+    // Release captured resources now, chunk is reused by next frames
+    entry.function = nullptr;
+
+    std::vector<JobId> successors;
+    {
+        std::lock_guard<std::mutex> lock(entry.mutex);
+        entry.done.store(true, std::memory_order_release);
+        successors.swap(entry.successors);
+    }
+
+    for (const JobId successor : successors)
+    {
+        if (job(successor).pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            schedule(successor);
+        }
+    }
+
+    // Keep vector capacity for the next job in this slot
+    successors.clear();
+    {
+        std::lock_guard<std::mutex> lock(entry.mutex);
+        entry.successors.swap(successors);
+    }
+
+    m_unfinished.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+JobSystem::workerLoop(std::size_t index)
+{
+    currentSystem = this;
+    currentIndex = index;
+
+    if (Trace::enabled())
+    {
+        Trace::setThreadName("EasyWindow worker");
+    }
+
+    while (!m_stop.load(std::memory_order_acquire))
+    {
+        bool executed = false;
+
+        for (int attempt = 0; attempt < SpinAttempts && !executed; ++attempt)
+        {
+            executed = executeOne(index);
+        }
+
+        if (executed)
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this]
+        {
+            return m_queued.load(std::memory_order_acquire) > 0 || m_stop.load(std::memory_order_relaxed);
+        });
+    }
+}
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
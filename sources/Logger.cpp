@@ -0,0 +1,382 @@
+#include <EasyWindow/Logger.hpp>
+
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdlib>
+#include <condition_variable>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+namespace
+{
+    /** Queued records count (power of two) */
+    constexpr std::uint64_t
+    QueueCapacity = 4096;
+
+    /** Logger thread wakes up this often even if nobody notifies it */
+    constexpr std::chrono::milliseconds
+    WakeInterval {10};
+
+    /**
+     * Slot of bounded queue. Sequence equals position of the slot while it is free
+     * for producer, position + 1 once record is written and can be consumed.
+     */
+    struct Slot
+    {
+        std::atomic<std::uint64_t>
+        sequence {0};
+
+        LogRecord
+        record {};
+    };
+
+    struct LoggerState
+    {
+        std::unique_ptr<Slot[]>
+        slots {};
+
+        alignas(64) std::atomic<std::uint64_t>
+        head {0};                   // next position for producers
+
+        alignas(64) std::atomic<std::uint64_t>
+        written {0};                // records passed to sink
+
+        std::uint64_t
+        tail {0};                   // logger thread only
+
+        std::atomic<std::uint64_t>
+        dropped {0};
+
+        std::atomic<std::uint64_t>
+        errors {0};
+
+        std::mutex
+        sinkMutex {};
+
+        LogSink
+        sink {};
+
+        std::mutex
+        wakeMutex {};
+
+        std::condition_variable
+        wake {};
+
+        std::condition_variable
+        flushed {};
+    };
+
+    const char*
+    levelName(ELogLevel level)
+    {
+        switch (level)
+        {
+            case ELogLevel::Info:       return "info";
+            case ELogLevel::Warning:    return "warning";
+            case ELogLevel::Error:      return "error";
+            case ELogLevel::None:       break;
+        }
+
+        return "none";
+    }
+
+    void
+    writeConsole(const LogEntry& entry)
+    {
+        if (entry.level == ELogLevel::Info)
+        {
+            std::fprintf(stdout, "EasyWindow [info]: %s\n", entry.message.c_str());
+            std::fflush(stdout);
+            return;
+        }
+
+        std::fprintf
+        (
+            stderr,
+            "EasyWindow [%s] in %s(): %s\n%s:%u\n",
+            levelName(entry.level),
+            entry.function,
+            entry.message.c_str(),
+            entry.file,
+            entry.line
+        );
+    }
+
+    void
+    writerLoop(LoggerState& state)
+    {
+        LogEntry entry;
+
+        for (;;)
+        {
+            Slot& slot = state.slots[state.tail & (QueueCapacity - 1)];
+
+            if (slot.sequence.load(std::memory_order_acquire) != state.tail + 1)
+            {
+                state.written.store(state.tail, std::memory_order_release);
+                state.flushed.notify_all();
+
+                std::unique_lock<std::mutex> lock(state.wakeMutex);
+                state.wake.wait_for(lock, WakeInterval);
+                continue;
+            }
+
+            const LogRecord& record = slot.record;
+
+            entry.level = record.level;
+            entry.time = record.time;
+            entry.function = record.function;
+            entry.file = record.file;
+            entry.line = record.line;
+            entry.message = Logger::format(record);
+
+            // Slot is free for producers once record is formatted
+            slot.sequence.store(state.tail + QueueCapacity, std::memory_order_release);
+            state.tail++;
+
+            std::lock_guard<std::mutex> lock(state.sinkMutex);
+
+            if (state.sink)
+            {
+                state.sink(entry);
+            }
+            else
+            {
+                writeConsole(entry);
+            }
+
+            // Published per record, so 'flush' returns while other threads keep logging
+            state.written.store(state.tail, std::memory_order_release);
+        }
+    }
+
+    LoggerState&
+    loggerState()
+    {
+        // Never destroyed, objects destroyed at exit may still log
+        static LoggerState* state = []
+        {
+            auto result = new LoggerState();
+            result->slots = std::make_unique<Slot[]>(QueueCapacity);
+
+            for (std::uint64_t i = 0; i < QueueCapacity; ++i)
+            {
+                result->slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+
+            std::thread(writerLoop, std::ref(*result)).detach();
+            std::atexit(Logger::flush);
+
+            return result;
+        }();
+
+        return *state;
+    }
+
+    template<typename T>
+    T
+    read(const unsigned char* data)
+    {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        return value;
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+std::atomic<ELogLevel>
+Logger::s_level {ELogLevel::Info};
+
+/* ####################################################################################### */
+/* Settings */
+/* ####################################################################################### */
+
+void
+Logger::setLevel(ELogLevel level)
+{
+    s_level.store(level, std::memory_order_relaxed);
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Logger::setSink(LogSink sink)
+{
+    auto& state = loggerState();
+
+    std::lock_guard<std::mutex> lock(state.sinkMutex);
+    state.sink = std::move(sink);
+}
+
+/* ####################################################################################### */
+/* Methods */
+/* ####################################################################################### */
+
+void
+Logger::push(const LogRecord& record)
+{
+    auto& state = loggerState();
+
+    if (record.level == ELogLevel::Error)
+    {
+        state.errors.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::uint64_t position = state.head.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+
+    for (;;)
+    {
+        slot = &state.slots[position & (QueueCapacity - 1)];
+        const auto sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto difference = std::int64_t(sequence - position);
+
+        if (difference == 0)
+        {
+            if (state.head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            // Slot still holds record written QueueCapacity positions ago, queue is full
+            state.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else
+        {
+            position = state.head.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::memcpy(&slot->record, &record, offsetof(LogRecord, payload) + record.size);
+    slot->sequence.store(position + 1, std::memory_order_release);
+
+    // Other levels are picked up by periodic wake up, notification is not free
+    if (record.level == ELogLevel::Error)
+    {
+        state.wake.notify_one();
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Logger::flush()
+{
+    auto& state = loggerState();
+    const auto target = state.head.load(std::memory_order_acquire);
+
+    std::unique_lock<std::mutex> lock(state.wakeMutex);
+
+    while (state.written.load(std::memory_order_acquire) < target)
+    {
+        state.wake.notify_one();
+        state.flushed.wait_for(lock, WakeInterval);
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+std::string
+Logger::format(const LogRecord& record)
+{
+    std::string result;
+    char buffer[64];
+
+    std::size_t offset = 0;
+
+    while (offset < record.size)
+    {
+        const auto tag = LogMessage::EArgument(record.payload[offset]);
+        const unsigned char* data = record.payload + offset + 1;
+
+        switch (tag)
+        {
+            case LogMessage::EArgument::String:
+            {
+                const auto length = read<std::uint16_t>(data);
+                result.append(reinterpret_cast<const char*>(data + sizeof(std::uint16_t)), length);
+                offset += 1 + sizeof(std::uint16_t) + length;
+                continue;
+            }
+            case LogMessage::EArgument::Signed:
+            {
+                std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(read<std::int64_t>(data)));
+                offset += 1 + sizeof(std::int64_t);
+                break;
+            }
+            case LogMessage::EArgument::Unsigned:
+            {
+                std::snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(read<std::uint64_t>(data)));
+                offset += 1 + sizeof(std::uint64_t);
+                break;
+            }
+            case LogMessage::EArgument::Floating:
+            {
+                std::snprintf(buffer, sizeof(buffer), "%g", read<double>(data));
+                offset += 1 + sizeof(double);
+                break;
+            }
+            case LogMessage::EArgument::Char:
+            {
+                buffer[0] = read<char>(data);
+                buffer[1] = '\0';
+                offset += 1 + sizeof(char);
+                break;
+            }
+            case LogMessage::EArgument::Bool:
+            {
+                std::snprintf(buffer, sizeof(buffer), "%s", read<bool>(data) ? "true" : "false");
+                offset += 1 + sizeof(bool);
+                break;
+            }
+            case LogMessage::EArgument::Pointer:
+            {
+                std::snprintf(buffer, sizeof(buffer), "%p", read<const void*>(data));
+                offset += 1 + sizeof(const void*);
+                break;
+            }
+            default:
+            {
+                return result;
+            }
+        }
+
+        result.append(buffer);
+    }
+
+    if (record.truncated)
+    {
+        result.append("...");
+    }
+
+    return result;
+}
+
+/* ####################################################################################### */
+/* Getters */
+/* ####################################################################################### */
+
+std::uint64_t
+Logger::droppedMessages()
+{
+    return loggerState().dropped.load(std::memory_order_relaxed);
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+std::uint64_t
+Logger::errorsCount()
+{
+    return loggerState().errors.load(std::memory_order_relaxed);
+}
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
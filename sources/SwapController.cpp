@@ -0,0 +1,92 @@
+#include <EasyWindow/SwapController.hpp>
+
+#include <algorithm>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+namespace
+{
+    /** Frame took longer than this many periods, so vsync made it wait for the next blank */
+    constexpr double
+    MissedRatio = 1.5;
+
+    /** Missed frames in history which make vsync to be turned off */
+    constexpr std::size_t
+    MissedLimit = 4;
+
+    /** Frame work has to fit into this part of period to turn vsync back on */
+    constexpr double
+    FitRatio = 0.85;
+}
+
+/* ####################################################################################### */
+/* Methods */
+/* ####################################################################################### */
+
+void
+SwapController::setMode(ESwapInterval mode, bool tearSupported)
+{
+    m_mode = mode;
+    m_historyCount = 0;
+    m_historyIndex = 0;
+
+    switch (mode)
+    {
+        case ESwapInterval::Immediate:  m_interval = 0; break;
+        case ESwapInterval::VSync:      m_interval = 1; break;
+        case ESwapInterval::Adaptive:   m_interval = tearSupported ? -1 : 1; break;
+        case ESwapInterval::Auto:       m_interval = 1; break;
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+bool
+SwapController::update(double tickDelta, double idleTime, double refreshRate)
+{
+    if (m_mode != ESwapInterval::Auto || refreshRate <= 0.0)
+    {
+        return false;
+    }
+
+    // Vsync hides how long frame really took, so it is judged by tick delta. Without
+    // vsync delta is work time plus pacing, and only the work matters.
+    m_history[m_historyIndex] = m_interval == 0 ? std::max(tickDelta - idleTime, 0.0) : tickDelta;
+    m_historyIndex = (m_historyIndex + 1) % HistorySize;
+    m_historyCount = std::min(m_historyCount + 1, HistorySize);
+
+    if (m_historyCount < HistorySize)
+    {
+        return false;
+    }
+
+    const double period = 1.0 / refreshRate;
+    const auto begin = m_history.begin();
+    const auto end = m_history.end();
+
+    bool change = false;
+
+    if (m_interval != 0)
+    {
+        const auto missed = std::count_if(begin, end, [&](double delta){ return delta > period * MissedRatio; });
+        change = std::size_t(missed) >= MissedLimit;
+    }
+    else
+    {
+        change = std::all_of(begin, end, [&](double work){ return work < period * FitRatio; });
+    }
+
+    if (!change)
+    {
+        return false;
+    }
+
+    m_interval = m_interval != 0 ? 0 : 1;
+    m_historyCount = 0;
+    m_historyIndex = 0;
+
+    return true;
+}
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
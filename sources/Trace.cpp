@@ -0,0 +1,210 @@
+#include <EasyWindow/Trace.hpp>
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <cstdio>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+namespace
+{
+    struct TraceRecord
+    {
+        const char* name;
+        std::uint64_t start;
+        std::uint64_t duration;
+    };
+
+    /**
+     * Events of one thread. Only owning thread writes records, 'count' is
+     * published after record is written, so readers see complete records only.
+     */
+    struct ThreadBuffer
+    {
+        std::unique_ptr<TraceRecord[]> records;
+        std::size_t capacity {0};
+        std::atomic<std::size_t> count {0};
+        std::atomic<std::uint64_t> dropped {0};
+        std::uint32_t id {0};
+        std::string name;
+    };
+
+    std::mutex
+    registryMutex;
+
+    std::vector<std::shared_ptr<ThreadBuffer>>
+    registry;
+
+    std::size_t
+    bufferCapacity = 1 << 16;
+
+    ThreadBuffer&
+    threadBuffer()
+    {
+        thread_local std::shared_ptr<ThreadBuffer> buffer = []
+        {
+            auto result = std::make_shared<ThreadBuffer>();
+
+            std::lock_guard<std::mutex> lock(registryMutex);
+            result->capacity = bufferCapacity;
+            result->records = std::make_unique<TraceRecord[]>(result->capacity);
+            result->id = std::uint32_t(registry.size() + 1);
+            registry.push_back(result);
+
+            return result;
+        }();
+
+        return *buffer;
+    }
+
+    void
+    writeEscaped(std::FILE* file, const char* text)
+    {
+        for (; *text; ++text)
+        {
+            if (*text == '"' || *text == '\\')
+            {
+                std::fputc('\\', file);
+            }
+            std::fputc(*text, file);
+        }
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+std::atomic<bool>
+Trace::s_enabled {false};
+
+/* ####################################################################################### */
+/* Settings */
+/* ####################################################################################### */
+
+void
+Trace::setEnabled(bool enabled)
+{
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Trace::setBufferCapacity(std::size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    bufferCapacity = capacity;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Trace::setThreadName(const std::string& name)
+{
+    auto& buffer = threadBuffer();
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer.name = name;
+}
+
+/* ####################################################################################### */
+/* Methods */
+/* ####################################################################################### */
+
+void
+Trace::record(const char* name, std::uint64_t start, std::uint64_t duration)
+{
+    auto& buffer = threadBuffer();
+    const auto index = buffer.count.load(std::memory_order_relaxed);
+
+    if (index >= buffer.capacity)
+    {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.records[index] = {name, start, duration};
+    buffer.count.store(index + 1, std::memory_order_release);
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+bool
+Trace::write(const std::string& path)
+{
+    std::FILE* file = std::fopen(path.data(), "w");
+
+    if (!file)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    std::fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+    bool first = true;
+
+    for (const auto& buffer : registry)
+    {
+        if (!buffer->name.empty())
+        {
+            std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", first ? "" : ",", buffer->id);
+            writeEscaped(file, buffer->name.data());
+            std::fprintf(file, "\"}}");
+            first = false;
+        }
+
+        const auto count = buffer->count.load(std::memory_order_acquire);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto& record = buffer->records[i];
+
+            std::fprintf(file, "%s{\"name\":\"", first ? "" : ",");
+            writeEscaped(file, record.name);
+            std::fprintf(file, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                buffer->id,
+                double(record.start) / 1000.0,
+                double(record.duration) / 1000.0);
+            first = false;
+        }
+    }
+
+    std::fprintf(file, "]}\n");
+
+    return std::fclose(file) == 0;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Trace::clear()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    for (auto& buffer : registry)
+    {
+        buffer->count.store(0, std::memory_order_release);
+        buffer->dropped.store(0, std::memory_order_relaxed);
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+std::uint64_t
+Trace::droppedEvents()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    std::uint64_t result = 0;
+    for (const auto& buffer : registry)
+    {
+        result += buffer->dropped.load(std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+EZWINDOW_NAMESPACE_END
\ No newline at end of file
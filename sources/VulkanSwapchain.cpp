@@ -0,0 +1,444 @@
+#include <EasyWindow/VulkanSwapchain.hpp>
+#include <EasyWindow/Logger.hpp>
+
+#ifdef EZWINDOW_VULKAN
+
+#include <limits>
+#include <algorithm>
+
+
+EZWINDOW_NAMESPACE_BEGIN
+
+namespace
+{
+    constexpr std::uint64_t
+    NoTimeout = std::numeric_limits<std::uint64_t>::max();
+
+    VkPresentModeKHR
+    vulkanPresentMode(EPresentMode mode)
+    {
+        switch (mode)
+        {
+            case EPresentMode::Immediate:   return VK_PRESENT_MODE_IMMEDIATE_KHR;
+            case EPresentMode::Mailbox:     return VK_PRESENT_MODE_MAILBOX_KHR;
+            case EPresentMode::Fifo:        return VK_PRESENT_MODE_FIFO_KHR;
+            case EPresentMode::FifoRelaxed: return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+        }
+
+        return VK_PRESENT_MODE_FIFO_KHR;
+    }
+
+    /** Modes tried in order when requested one is not supported, Fifo always is */
+    std::vector<EPresentMode>
+    presentModeFallbacks(EPresentMode mode)
+    {
+        switch (mode)
+        {
+            case EPresentMode::Immediate:   return {EPresentMode::Immediate, EPresentMode::Mailbox};
+            case EPresentMode::Mailbox:     return {EPresentMode::Mailbox, EPresentMode::Immediate};
+            case EPresentMode::FifoRelaxed: return {EPresentMode::FifoRelaxed};
+            case EPresentMode::Fifo:        break;
+        }
+
+        return {};
+    }
+}
+
+/* ####################################################################################### */
+/* Constructors */
+/* ####################################################################################### */
+
+VulkanSwapchain::~VulkanSwapchain()
+{
+    std::vector<VkFence> fences;
+    for (const auto& slot : m_slots)
+    {
+        fences.push_back(slot.fence);
+    }
+
+    // Only swapchain teardown waits for GPU, resize never does
+    if (!fences.empty())
+    {
+        vkWaitForFences(m_config.device, std::uint32_t(fences.size()), fences.data(), VK_TRUE, NoTimeout);
+    }
+    vkQueueWaitIdle(m_config.presentQueue);
+
+    collectRetired(true);
+    destroyImages(m_views, m_rendered);
+
+    if (m_swapchain)
+    {
+        vkDestroySwapchainKHR(m_config.device, m_swapchain, m_config.allocator);
+    }
+
+    for (const auto& slot : m_slots)
+    {
+        vkDestroySemaphore(m_config.device, slot.acquired, m_config.allocator);
+        vkDestroyFence(m_config.device, slot.fence, m_config.allocator);
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+VulkanSwapchain::VulkanSwapchain(const VulkanSwapchainConfig& config, VkExtent2D extent)
+    : m_config(config)
+    , m_requestedExtent(extent)
+    , m_presentMode(config.presentMode)
+{
+    m_slots.resize(std::max<std::uint32_t>(config.framesInFlight, 1));
+
+    VkSemaphoreCreateInfo semaphoreInfo {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    VkFenceCreateInfo fenceInfo {};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+    for (auto& slot : m_slots)
+    {
+        if (vkCreateSemaphore(config.device, &semaphoreInfo, config.allocator, &slot.acquired) != VK_SUCCESS ||
+            vkCreateFence(config.device, &fenceInfo, config.allocator, &slot.fence) != VK_SUCCESS)
+        {
+            EZWINDOW_ERROR("Cant create swapchain frame sync objects");
+
+            // Swapchain without frame slots never acquires
+            for (const auto& created : m_slots)
+            {
+                vkDestroySemaphore(config.device, created.acquired, config.allocator);
+                vkDestroyFence(config.device, created.fence, config.allocator);
+            }
+            m_slots.clear();
+
+            return;
+        }
+    }
+
+    recreate();
+}
+
+/* ####################################################################################### */
+/* Methods */
+/* ####################################################################################### */
+
+bool
+VulkanSwapchain::acquire(VulkanFrame& frame)
+{
+    if (m_slots.empty())
+    {
+        return false;
+    }
+
+    const Slot& slot = m_slots[m_slot];
+
+    // Slot is free once GPU finished the frame submitted with it framesInFlight frames ago
+    vkWaitForFences(m_config.device, 1, &slot.fence, VK_TRUE, NoTimeout);
+    collectRetired(false);
+
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        if (m_outdated && !recreate())
+        {
+            return false;
+        }
+
+        std::uint32_t imageIndex = 0;
+        const VkResult result = vkAcquireNextImageKHR
+        (
+            m_config.device,
+            m_swapchain,
+            NoTimeout,
+            slot.acquired,
+            VK_NULL_HANDLE,
+            &imageIndex
+        );
+
+        if (result == VK_ERROR_OUT_OF_DATE_KHR)
+        {
+            m_outdated = true;
+            continue;
+        }
+
+        if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
+        {
+            return false;
+        }
+
+        // Suboptimal image is still rendered, swapchain is replaced after present
+        if (result == VK_SUBOPTIMAL_KHR)
+        {
+            m_outdated = true;
+        }
+
+        vkResetFences(m_config.device, 1, &slot.fence);
+
+        frame.slot = m_slot;
+        frame.imageIndex = imageIndex;
+        frame.image = m_images[imageIndex];
+        frame.view = m_views[imageIndex];
+        frame.extent = m_extent;
+        frame.acquired = slot.acquired;
+        frame.rendered = m_rendered[imageIndex];
+        frame.fence = slot.fence;
+
+        return true;
+    }
+
+    return false;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+VkResult
+VulkanSwapchain::present(const VulkanFrame& frame)
+{
+    VkPresentInfoKHR info {};
+    info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    info.waitSemaphoreCount = 1;
+    info.pWaitSemaphores = &frame.rendered;
+    info.swapchainCount = 1;
+    info.pSwapchains = &m_swapchain;
+    info.pImageIndices = &frame.imageIndex;
+
+    const auto start = nowNanoseconds();
+    const VkResult result = vkQueuePresentKHR(m_config.presentQueue, &info);
+
+    if (m_presentHook)
+    {
+        m_presentHook(start, nowNanoseconds() - start);
+    }
+
+    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+    {
+        m_outdated = true;
+    }
+
+    m_slot = (m_slot + 1) % std::uint32_t(m_slots.size());
+    ++m_frame;
+
+    return result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR ? VK_SUCCESS : result;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+VulkanSwapchain::resize(VkExtent2D extent)
+{
+    if (extent.width != m_requestedExtent.width || extent.height != m_requestedExtent.height)
+    {
+        m_requestedExtent = extent;
+        m_outdated = true;
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+VulkanSwapchain::setPresentMode(EPresentMode mode)
+{
+    if (mode != m_config.presentMode)
+    {
+        m_config.presentMode = mode;
+        m_outdated = true;
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+VulkanSwapchain::setPresentHook(PresentHook hook)
+{
+    m_presentHook = std::move(hook);
+}
+
+/* ####################################################################################### */
+/* Internals */
+/* ####################################################################################### */
+
+bool
+VulkanSwapchain::recreate()
+{
+    VkSurfaceCapabilitiesKHR capabilities {};
+    if (vkGetPhysicalDeviceSurfaceCapabilitiesKHR(m_config.physicalDevice, m_config.surface, &capabilities) != VK_SUCCESS)
+    {
+        return false;
+    }
+
+    VkExtent2D extent = capabilities.currentExtent;
+
+    // Surface size is defined by swapchain
+    if (extent.width == std::numeric_limits<std::uint32_t>::max())
+    {
+        extent.width = std::clamp(m_requestedExtent.width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
+        extent.height = std::clamp(m_requestedExtent.height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
+    }
+
+    // Minimized window, keep old swapchain until it has a size again
+    if (extent.width == 0 || extent.height == 0)
+    {
+        return false;
+    }
+
+    std::uint32_t formatsCount = 0;
+    vkGetPhysicalDeviceSurfaceFormatsKHR(m_config.physicalDevice, m_config.surface, &formatsCount, nullptr);
+    std::vector<VkSurfaceFormatKHR> formats(formatsCount);
+    vkGetPhysicalDeviceSurfaceFormatsKHR(m_config.physicalDevice, m_config.surface, &formatsCount, formats.data());
+
+    if (formats.empty())
+    {
+        return false;
+    }
+
+    m_format = formats.front();
+    for (const auto& format : formats)
+    {
+        if (format.format == m_config.format.format && format.colorSpace == m_config.format.colorSpace)
+        {
+            m_format = format;
+            break;
+        }
+    }
+
+    std::uint32_t imagesCount = std::max(capabilities.minImageCount + 1, std::uint32_t(m_slots.size()));
+    if (capabilities.maxImageCount > 0)
+    {
+        imagesCount = std::min(imagesCount, capabilities.maxImageCount);
+    }
+
+    VkSwapchainCreateInfoKHR info {};
+    info.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+    info.surface = m_config.surface;
+    info.minImageCount = imagesCount;
+    info.imageFormat = m_format.format;
+    info.imageColorSpace = m_format.colorSpace;
+    info.imageExtent = extent;
+    info.imageArrayLayers = 1;
+    info.imageUsage = m_config.imageUsage;
+    info.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    info.preTransform = capabilities.currentTransform;
+    info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+    info.presentMode = choosePresentMode();
+    info.clipped = VK_TRUE;
+    info.oldSwapchain = m_swapchain;
+
+    VkSwapchainKHR swapchain = VK_NULL_HANDLE;
+    if (vkCreateSwapchainKHR(m_config.device, &info, m_config.allocator, &swapchain) != VK_SUCCESS)
+    {
+        EZWINDOW_WARNING("Cant create swapchain");
+        return false;
+    }
+
+    // Old swapchain may still be used by frames in flight, it is destroyed when their fences pass
+    if (m_swapchain)
+    {
+        m_retired.push_back({m_swapchain, std::move(m_views), std::move(m_rendered), m_frame});
+        m_views.clear();
+        m_rendered.clear();
+        ++m_recreations;
+    }
+
+    m_swapchain = swapchain;
+    m_extent = extent;
+
+    std::uint32_t count = 0;
+    vkGetSwapchainImagesKHR(m_config.device, m_swapchain, &count, nullptr);
+    m_images.resize(count);
+    vkGetSwapchainImagesKHR(m_config.device, m_swapchain, &count, m_images.data());
+
+    VkSemaphoreCreateInfo semaphoreInfo {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    m_views.resize(count, VK_NULL_HANDLE);
+    m_rendered.resize(count, VK_NULL_HANDLE);
+
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        VkImageViewCreateInfo viewInfo {};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = m_images[i];
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = m_format.format;
+        viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.layerCount = 1;
+
+        if (vkCreateImageView(m_config.device, &viewInfo, m_config.allocator, &m_views[i]) != VK_SUCCESS ||
+            vkCreateSemaphore(m_config.device, &semaphoreInfo, m_config.allocator, &m_rendered[i]) != VK_SUCCESS)
+        {
+            EZWINDOW_ERROR("Cant create swapchain image resources");
+            return false;
+        }
+    }
+
+    m_outdated = false;
+
+    return true;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+VulkanSwapchain::collectRetired(bool all)
+{
+    // Fence of every slot was waited after retirement, so no frame uses old images anymore
+    const auto done = [&](const Retired& retired)
+    {
+        return all || m_frame >= retired.frame + m_slots.size();
+    };
+
+    for (auto& retired : m_retired)
+    {
+        if (done(retired))
+        {
+            destroyImages(retired.views, retired.rendered);
+            vkDestroySwapchainKHR(m_config.device, retired.swapchain, m_config.allocator);
+        }
+    }
+
+    m_retired.erase(std::remove_if(m_retired.begin(), m_retired.end(), done), m_retired.end());
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+VulkanSwapchain::destroyImages(std::vector<VkImageView>& views, std::vector<VkSemaphore>& rendered)
+{
+    for (const auto view : views)
+    {
+        vkDestroyImageView(m_config.device, view, m_config.allocator);
+    }
+
+    for (const auto semaphore : rendered)
+    {
+        vkDestroySemaphore(m_config.device, semaphore, m_config.allocator);
+    }
+
+    views.clear();
+    rendered.clear();
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+VkPresentModeKHR
+VulkanSwapchain::choosePresentMode()
+{
+    std::uint32_t count = 0;
+    vkGetPhysicalDeviceSurfacePresentModesKHR(m_config.physicalDevice, m_config.surface, &count, nullptr);
+    std::vector<VkPresentModeKHR> supported(count);
+    vkGetPhysicalDeviceSurfacePresentModesKHR(m_config.physicalDevice, m_config.surface, &count, supported.data());
+
+    for (const auto mode : presentModeFallbacks(m_config.presentMode))
+    {
+        if (std::find(supported.begin(), supported.end(), vulkanPresentMode(mode)) != supported.end())
+        {
+            m_presentMode = mode;
+            return vulkanPresentMode(mode);
+        }
+    }
+
+    m_presentMode = EPresentMode::Fifo;
+    return VK_PRESENT_MODE_FIFO_KHR;
+}
+
+EZWINDOW_NAMESPACE_END
+
+#endif
\ No newline at end of file
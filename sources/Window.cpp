@@ -1,4 +1,6 @@
 #include <EasyWindow/Window.hpp>
+#include <EasyWindow/Logger.hpp>
+#include <EasyWindow/FrameAwaiter.hpp>
 
 #ifdef EZWINDOW_OPENGL
     #include <GL/glew.h>
@@ -15,6 +17,16 @@
 
 #include <GLFW/glfw3.h>
 
+#include <thread>
+#include <cstdlib>
+#include <algorithm>
+
+#ifdef EZWINDOW_WINDOWS
+    #include <windows.h>
+#else
+    #include <dlfcn.h>
+#endif
+
 #ifndef EZWINDOW_OPENGL
     #ifdef EZWINDOW_LINUX
         #define GLFW_EXPOSE_NATIVE_X11
@@ -29,112 +41,255 @@
 
 EZWINDOW_NAMESPACE_BEGIN
 
+namespace
+{
+    /**
+     * Finds monitor containing given point of virtual desktop.
+     */
+    GLFWmonitor*
+    monitorAt(int x, int y)
+    {
+        int count = 0;
+        GLFWmonitor** monitors = glfwGetMonitors(&count);
+
+        for (int i = 0; i < count; ++i)
+        {
+            const GLFWvidmode* mode = glfwGetVideoMode(monitors[i]);
+            if (!mode)
+            {
+                continue;
+            }
+
+            int mx = 0;
+            int my = 0;
+            glfwGetMonitorPos(monitors[i], &mx, &my);
+
+            if (x >= mx && x < mx + mode->width && y >= my && y < my + mode->height)
+            {
+                return monitors[i];
+            }
+        }
+
+        return glfwGetPrimaryMonitor();
+    }
+
+    /** GLFW users count, library is terminated when the last one is gone */
+    std::mutex
+    platformMutex;
+
+    std::size_t
+    platformUsers = 0;
+
+    /** How often OnDemand loop wakes to collect finished uploads (in seconds) */
+    constexpr double
+    uploadPollInterval = 0.002;
+
+    /** Create invisible windows, on GLFW null platform if it is available */
+    bool
+    headlessMode = false;
+
+#ifdef GLFW_PLATFORM_NULL
+    /**
+     * Checks whether headless windows go to GLFW null platform. OpenGL prefers hidden
+     * X11 window when there is a display (Xvfb), GLEW built for GLX resolves functions
+     * through GLX and can't reliably load them for OSMesa context of null platform.
+     */
+    bool
+    headlessNullPlatform()
+    {
+        if (!glfwPlatformSupported(GLFW_PLATFORM_NULL))
+        {
+            return false;
+        }
+
+#if defined(EZWINDOW_OPENGL) && defined(EZWINDOW_LINUX)
+        const char* display = std::getenv("DISPLAY");
+
+        if (display && display[0] != '\0' && glfwPlatformSupported(GLFW_PLATFORM_X11))
+        {
+            return false;
+        }
+#endif
+
+        return true;
+    }
+#endif
+
+    /** Loads platform libraries ahead of glfwInit, joined by the first glfwInit */
+    struct PreloadThread : std::thread
+    {
+        ~PreloadThread()
+        {
+            if (joinable())
+            {
+                join();
+            }
+        }
+    }
+    preloadThread;
+
+    /**
+     * Loads libraries GLFW and render backend load on init, so the loader pays for
+     * them in background. Handles are never closed, GLFW gets the same ones.
+     */
+    void
+    preloadLibraries(bool nullPlatform)
+    {
+#ifdef EZWINDOW_LINUX
+        const char* windowSystem[] = {"libX11.so.6", "libXrandr.so.2", "libXcursor.so.1", "libXi.so.6", "libXinerama.so.1", "libX11-xcb.so.1"};
+
+        if (!nullPlatform)
+        {
+            for (const char* library : windowSystem)
+            {
+                dlopen(library, RTLD_LAZY | RTLD_LOCAL);
+            }
+        }
+
+    #ifdef EZWINDOW_OPENGL
+        dlopen("libGLX.so.0", RTLD_LAZY | RTLD_LOCAL);
+        dlopen("libGL.so.1", RTLD_LAZY | RTLD_LOCAL);
+    #endif
+#elif defined(EZWINDOW_WINDOWS) && defined(EZWINDOW_OPENGL)
+        LoadLibraryA("opengl32.dll");
+#endif
+
+#ifdef EZWINDOW_VULKAN
+        // First loader call scans and loads drivers (ICDs) and implicit layers
+        uint32_t count = 0;
+        vkEnumerateInstanceExtensionProperties(nullptr, &count, nullptr);
+#endif
+    }
+
+    /** Trace names of dispatched events */
+    const char*
+    eventName(EEventType type)
+    {
+        switch (type)
+        {
+            case EEventType::Resize:       return "event.resize";
+            case EEventType::Refresh:      return "event.refresh";
+            case EEventType::Key:          return "event.key";
+            case EEventType::MouseArea:    return "event.mouse_area";
+            case EEventType::MouseMove:    return "event.mouse_move";
+            case EEventType::Button:       return "event.button";
+            case EEventType::Scroll:       return "event.scroll";
+            case EEventType::Framebuffer:  return "event.framebuffer";
+            case EEventType::Scale:        return "event.scale";
+        }
+
+        return "event";
+    }
+
+    /** Config of constructors taking only origin corner and share context */
+    WindowConfig
+    defaultConfig(EOriginCorner originCorner, Window* shareContext)
+    {
+        WindowConfig config;
+        config.originCorner = originCorner;
+        config.shareContext = shareContext;
+        return config;
+    }
+
+    /** Window new windows share context with unless another one is given explicitly */
+    thread_local Window*
+    defaultShareContext = nullptr;
+}
+
 /* ####################################################################################### */
 /* Constructors */
 /* ####################################################################################### */
 
 Window::~Window()
 {
+    // Coroutines still waiting for this window would never be resumed
+    for (const auto& [wait, task] : m_tasks)
+    {
+        task.destroy(task.handle);
+    }
+
+#ifdef EZWINDOW_OPENGL
+    if ((m_capture || m_streamBuffer || !m_uploadContexts.empty()) && m_window)
+    {
+        glfwMakeContextCurrent(m_window);
+        stopCapture();
+        destroyStreamBuffer();
+        destroyUploadContexts();
+    }
+#endif
+
+#ifdef EZWINDOW_VULKAN
+    destroyVulkanSwapchain();
+#endif
+
     if (m_window)
     {
-        glfwTerminate();
         glfwDestroyWindow(m_window);
         m_window = nullptr;
     }
+
+    if (m_platform)
+    {
+        releasePlatform();
+    }
 }
 
 /* --------------------------------------------------------------------------------------- */
 
 Window::Window(EOriginCorner originCorner)
-    : m_originCorner(originCorner)
+    : Window(originCorner, nullptr)
 {
-    if (glfwInit() != GLFW_TRUE)
-    {
-        EZWINDOW_ERROR("Cant initialize GLFW");
-    }
-
-#ifdef EZWINDOW_OPENGL
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-#else
-    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
-#endif
-
-    setVisible(m_visible);
-    setSamples(m_samples);
-    setChannelsBits(m_channels);
-    setDoubleBufferEnabled(m_doubleBuffer);
 
-    m_window = glfwCreateWindow(m_size.w, m_size.h, m_title.data(), nullptr, nullptr);
+}
 
-#ifdef EZWINDOW_OPENGL
-    glfwMakeContextCurrent(m_window);
-    glewExperimental = GL_TRUE;
+/* --------------------------------------------------------------------------------------- */
 
-    GLenum GLEWInitResult = glewInit();
-    if (GLEWInitResult != GLEW_OK)
-    {
-        EZWINDOW_ERROR(glewGetErrorString(GLEWInitResult));
-    }
-#endif
-    
-    if (!m_window)
-    {
-        EZWINDOW_ERROR("Cant create GLFW window");
-    }
+Window::Window(EOriginCorner originCorner, Window* shareContext)
+    : Window(defaultConfig(originCorner, shareContext))
+{
 
-    glfwSetWindowUserPointer(m_window, this);
+}
 
-    glfwSetWindowSizeCallback(m_window, [](GLFWwindow* window, int w, int h)
-    {
-        auto* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
-        self->setSize({uint64_t(w), uint64_t(h)});
-        self->resizeEvent();
-    });
+/* --------------------------------------------------------------------------------------- */
 
-    glfwSetKeyCallback(m_window, [](GLFWwindow* window, int key, int scancode, int action, int mods)
-    {
-        auto* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
-        self->keyEvent
-        (
-            static_cast<EKey>(key),
-            static_cast<EState>(action),
-            static_cast<EModifier>(mods)
-        );
-    });
+Window::Window(const WindowConfig& config)
+    : Window(config, AllEvents, &Window::dispatchHandlers)
+{
 
-    glfwSetCursorPosCallback(m_window, [](GLFWwindow* window, double x, double y)
-    {
-        auto* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
+}
 
-        double ys[2] = {y, self->size().h - y};
+/* --------------------------------------------------------------------------------------- */
 
-        self->mouseMoveEvent(Vector<uint64_t>{uint64_t(x), uint64_t(ys[uint8_t(self->m_originCorner)])});
-    });
+Window::Window(const WindowConfig& config, std::uint32_t eventMask, EventDispatch dispatch)
+    : m_eventMask(eventMask)
+    , m_dispatch(dispatch)
+    , m_originCorner(config.originCorner)
+    , m_shareContext(config.shareContext)
+    , m_channels(config.channels)
+    , m_title(config.title)
+    , m_size(config.size)
+    , m_framebufferSize(config.size)
+    , m_samples(config.samples)
+    , m_visible(config.visible)
+    , m_doubleBuffer(config.doubleBuffer)
+{
+    m_platform = acquirePlatform();
 
-    glfwSetCursorEnterCallback(m_window, [](GLFWwindow* window, int entered)
+    if (!m_platform)
     {
-        auto* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
-        self->mouseAreaEvent(bool(entered));
-    });
+        EZWINDOW_ERROR("Cant initialize GLFW");
+        return;
+    }
 
-    glfwSetMouseButtonCallback(m_window, [](GLFWwindow* window, int button, int action, int mods)
+    if (!m_shareContext)
     {
-        auto* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
-        self->buttonEvent
-        (
-            static_cast<EButton>(button),
-            static_cast<EState>(action),
-            static_cast<EModifier>(mods)
-        );
-    });
+        m_shareContext = defaultShareContext;
+    }
 
-    glfwSetScrollCallback(m_window, [](GLFWwindow* window, double x, double y)
+    if (!config.deferred)
     {
-        auto* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
-        self->scrollEvent(Vector<double>{x,y});
-    });
+        create();
+    }
 }
 
 /* ####################################################################################### */
@@ -145,7 +300,12 @@ void
 Window::setSize(const Size<uint64_t>& size)
 {
     m_size = size;
-    glfwSetWindowSize(m_window, m_size.w, m_size.h);
+
+    if (m_window)
+    {
+        m_resized = true;
+        glfwSetWindowSize(m_window, m_size.w, m_size.h);
+    }
 }
 
 /* --------------------------------------------------------------------------------------- */
@@ -154,7 +314,20 @@ void
 Window::setVisible(bool visible)
 {
     m_visible = visible;
-    glfwWindowHint(GLFW_VISIBLE, visible);
+
+    if (!m_window)
+    {
+        return;
+    }
+
+    if (visible)
+    {
+        glfwShowWindow(m_window);
+    }
+    else
+    {
+        glfwHideWindow(m_window);
+    }
 }
 
 /* --------------------------------------------------------------------------------------- */
@@ -174,8 +347,12 @@ Window::setTitle(const std::string& title)
 void
 Window::setSamples(int samplesCount)
 {
+    if (m_window)
+    {
+        EZWINDOW_WARNING("Window is already created, attribute takes effect for deferred window only");
+    }
+
     m_samples = samplesCount;
-    glfwWindowHint(GLFW_SAMPLES, samplesCount);
 }
 
 /* --------------------------------------------------------------------------------------- */
@@ -183,8 +360,12 @@ Window::setSamples(int samplesCount)
 void
 Window::setDoubleBufferEnabled(bool enabled)
 {
+    if (m_window)
+    {
+        EZWINDOW_WARNING("Window is already created, attribute takes effect for deferred window only");
+    }
+
     m_doubleBuffer = enabled;
-    glfwWindowHint(GLFW_DOUBLEBUFFER, enabled);
 }
 
 /* --------------------------------------------------------------------------------------- */
@@ -192,30 +373,172 @@ Window::setDoubleBufferEnabled(bool enabled)
 void
 Window::setChannelsBits(const ChannelsBits& bits)
 {
+    if (m_window)
+    {
+        EZWINDOW_WARNING("Window is already created, attribute takes effect for deferred window only");
+    }
+
     m_channels = bits;
-    glfwWindowHint(GLFW_RED_BITS, bits.r);
-    glfwWindowHint(GLFW_GREEN_BITS, bits.g);
-    glfwWindowHint(GLFW_BLUE_BITS, bits.b);
-    glfwWindowHint(GLFW_ALPHA_BITS, bits.a);
-    glfwWindowHint(GLFW_DEPTH_BITS, bits.d);
-    glfwWindowHint(GLFW_STENCIL_BITS, bits.s);
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::setLoopMode(ELoopMode mode, double idleTimeout)
+{
+    m_loopMode = mode;
+    m_idleTimeout = idleTimeout;
+    requestRedraw();
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::setMouseMotionCoalescing(bool enabled)
+{
+    m_coalesceMotion = enabled;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::setMouseMotionHistory(std::size_t capacity)
+{
+    m_motionHistory.resize(capacity);
+    m_motionHistoryCount = 0;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::setCursorLocked(bool locked)
+{
+    m_cursorLocked = locked;
+
+    if (!m_window)
+    {
+        return;
+    }
+
+    glfwSetInputMode(m_window, GLFW_CURSOR, locked ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+bool
+Window::setRawMouseMotion(bool enabled)
+{
+    if (!m_platform || !glfwRawMouseMotionSupported())
+    {
+        return false;
+    }
+
+    m_rawMouseMotion = enabled;
+
+    if (m_window)
+    {
+        glfwSetInputMode(m_window, GLFW_RAW_MOUSE_MOTION, enabled ? GLFW_TRUE : GLFW_FALSE);
+    }
+
+    return true;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::setFrameStatsPath(const std::string& path)
+{
+    m_statsPath = path;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::setEventRecorder(EventRecorder* recorder)
+{
+    m_recorder = recorder;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::setEventReplay(EventReplay* replay)
+{
+    m_replay = replay;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::setJobSystem(JobSystem* jobs)
+{
+    m_jobs = jobs;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::setThreadedRendering(bool enabled)
+{
+    m_threadedRendering = enabled;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::setFramePacing(EFramePacing pacing, double rate)
+{
+    m_pacing = pacing;
+    m_targetRate = rate;
+    updateFramePacing();
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::setSwapInterval(ESwapInterval mode)
+{
+    m_swap.setMode(mode, m_swapTearSupported);
+    m_swapPending = true;
 }
 
 /* ####################################################################################### */
 /* Getters */
 /* ####################################################################################### */
 
-Vector<uint64_t>
-Window::mousePosition()
+double
+Window::monitorRefreshRate()
 {
-    double x = 0;
-    double y = 0;
+    if (!m_window)
+    {
+        return 0.0;
+    }
+
+    GLFWmonitor* monitor = glfwGetWindowMonitor(m_window);
+
+    if (!monitor)
+    {
+        // Size is queried from GLFW, 'm_size' belongs to render thread in threaded mode
+        int x = 0;
+        int y = 0;
+        int w = 0;
+        int h = 0;
+        glfwGetWindowPos(m_window, &x, &y);
+        glfwGetWindowSize(m_window, &w, &h);
+        monitor = monitorAt(x + w / 2, y + h / 2);
+    }
 
-    glfwGetCursorPos(m_window, &x, &y);
+    const GLFWvidmode* mode = monitor ? glfwGetVideoMode(monitor) : nullptr;
+
+    return mode ? double(mode->refreshRate) : 0.0;
+}
 
-    double ys[2] = {y, size().h - y};
+/* --------------------------------------------------------------------------------------- */
 
-    return {uint64_t(x), uint64_t(ys[uint8_t(m_originCorner)])};
+Vector<uint64_t>
+Window::mousePosition()
+{
+    return m_mousePosition;
 }
 
 /* --------------------------------------------------------------------------------------- */
@@ -248,7 +571,7 @@ Window::mouseOffset()
 bool
 Window::isMouseInWindow()
 {
-    return bool(glfwGetWindowAttrib(m_window, GLFW_HOVERED));
+    return m_cursorInside;
 }
 
 /* --------------------------------------------------------------------------------------- */
@@ -256,7 +579,7 @@ Window::isMouseInWindow()
 double
 Window::time() const
 {
-    return m_time;
+    return double(m_clock.time()) * 1e-9;
 }
 
 /* --------------------------------------------------------------------------------------- */
@@ -264,7 +587,7 @@ Window::time() const
 double
 Window::tickDelta() const
 {
-    return m_curr_tick;
+    return double(m_clock.delta()) * 1e-9;
 }
 
 /* ####################################################################################### */
@@ -301,69 +624,435 @@ Window::nativeDisplayType()
 /* Render backend methods */
 /* ####################################################################################### */
 
-#ifdef EZWINDOW_VULKAN
-std::int64_t
-Window::createVulkanSurface(void* instance, void* surface, const void* allocationCallbacks)
+#ifdef EZWINDOW_OPENGL
+GLStreamBuffer&
+Window::createStreamBuffer(std::uint64_t frameSize, std::uint32_t framesCount)
 {
-    return glfwCreateWindowSurface
-    (
-        *reinterpret_cast<VkInstance*>(instance),
-        m_window,
-        reinterpret_cast<const VkAllocationCallbacks*>(allocationCallbacks),
-        reinterpret_cast<VkSurfaceKHR*>(surface)
-    );
+    m_streamBuffer.reset();
+    m_streamBuffer = std::make_unique<GLStreamBuffer>(frameSize, framesCount);
+
+    return *m_streamBuffer;
 }
 
 /* --------------------------------------------------------------------------------------- */
 
-std::vector<std::string>
-Window::vulkanExtensions()
+void
+Window::destroyStreamBuffer()
 {
-    uint32_t count = 0;
-    const char** extensions = glfwGetRequiredInstanceExtensions(&count);
+    m_streamBuffer.reset();
+}
 
-    std::vector<std::string> result;
-    result.reserve(count);
+/* --------------------------------------------------------------------------------------- */
 
-    for (uint32_t i = 0; i < count; ++i)
+void
+Window::createUploadContexts(std::size_t count)
+{
+    if (!m_window)
     {
-        result.emplace_back(extensions[i]);
+        EZWINDOW_WARNING("GLFW window is not created yet");
+        return;
     }
 
-    return result;
-}
+    destroyUploadContexts();
+
+    m_uploadContexts.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        m_uploadContexts.push_back(std::make_unique<GLUploadContext>(m_window));
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::destroyUploadContexts()
+{
+    m_uploadContexts.clear();
+}
+#endif
+
+#ifdef EZWINDOW_VULKAN
+std::int64_t
+Window::createVulkanSurface(void* instance, void* surface, const void* allocationCallbacks)
+{
+    return glfwCreateWindowSurface
+    (
+        *reinterpret_cast<VkInstance*>(instance),
+        m_window,
+        reinterpret_cast<const VkAllocationCallbacks*>(allocationCallbacks),
+        reinterpret_cast<VkSurfaceKHR*>(surface)
+    );
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+std::vector<std::string>
+Window::vulkanExtensions()
+{
+    uint32_t count = 0;
+    const char** extensions = glfwGetRequiredInstanceExtensions(&count);
+
+    std::vector<std::string> result;
+    result.reserve(count);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        result.emplace_back(extensions[i]);
+    }
+
+    return result;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+VulkanSwapchain&
+Window::createVulkanSwapchain(const VulkanSwapchainConfig& config)
+{
+    stopCapture();
+    m_swapchain.reset();
+    m_swapchain = std::make_unique<VulkanSwapchain>(config, VkExtent2D{std::uint32_t(m_framebufferSize.w), std::uint32_t(m_framebufferSize.h)});
+
+    // Present is swap of Vulkan frame, it feeds swap stats and swap interval control
+    m_swapchain->setPresentHook([this](std::uint64_t start, std::uint64_t duration)
+    {
+        recordSwap(start, duration);
+    });
+
+    return *m_swapchain;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::destroyVulkanSwapchain()
+{
+    // Capture reads swapchain images and uses its device
+    stopCapture();
+    m_swapchain.reset();
+}
+#endif
+
+#if defined(EZWINDOW_OPENGL) || defined(EZWINDOW_VULKAN)
+bool
+Window::startCapture(const CaptureConfig& config)
+{
+    stopCapture();
+
+#ifdef EZWINDOW_OPENGL
+    if (!m_window)
+    {
+        EZWINDOW_WARNING("GLFW window is not created yet");
+        return false;
+    }
+
+    m_capture = std::make_unique<FrameCapture>(config);
+#endif
+
+#ifdef EZWINDOW_VULKAN
+    if (!m_swapchain)
+    {
+        EZWINDOW_WARNING("Capture needs swapchain created by 'createVulkanSwapchain'");
+        return false;
+    }
+
+    if ((m_swapchain->config().imageUsage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) == 0)
+    {
+        EZWINDOW_WARNING("Capture needs swapchain images with VK_IMAGE_USAGE_TRANSFER_SRC_BIT usage");
+        return false;
+    }
+
+    m_capture = std::make_unique<FrameCapture>(config, *m_swapchain);
+#endif
+
+    return true;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::stopCapture()
+{
+    m_capture.reset();
+}
 #endif
 
 /* ####################################################################################### */
 /* Methods */
 /* ####################################################################################### */
 
+void
+Window::create()
+{
+    if (m_window)
+    {
+        EZWINDOW_WARNING("GLFW window is already created");
+        return;
+    }
+
+    if (!m_platform)
+    {
+        EZWINDOW_ERROR("Cant create GLFW window, GLFW is not initialized");
+        return;
+    }
+
+    // Hints are global, don't inherit the ones left by another window
+    glfwDefaultWindowHints();
+
+#ifdef EZWINDOW_OPENGL
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#else
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+#endif
+
+    glfwWindowHint(GLFW_VISIBLE, m_visible);
+    glfwWindowHint(GLFW_SAMPLES, int(m_samples));
+    glfwWindowHint(GLFW_DOUBLEBUFFER, m_doubleBuffer);
+    glfwWindowHint(GLFW_RED_BITS, m_channels.r);
+    glfwWindowHint(GLFW_GREEN_BITS, m_channels.g);
+    glfwWindowHint(GLFW_BLUE_BITS, m_channels.b);
+    glfwWindowHint(GLFW_ALPHA_BITS, m_channels.a);
+    glfwWindowHint(GLFW_DEPTH_BITS, m_channels.d);
+    glfwWindowHint(GLFW_STENCIL_BITS, m_channels.s);
+
+    if (headlessMode)
+    {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+#if defined(EZWINDOW_OPENGL) && defined(GLFW_PLATFORM_NULL)
+        // Null platform has no native context API, render with OSMesa (llvmpipe)
+        if (glfwGetPlatform() == GLFW_PLATFORM_NULL)
+        {
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+        }
+#endif
+    }
+
+    m_window = glfwCreateWindow
+    (
+        m_size.w,
+        m_size.h,
+        m_title.data(),
+        nullptr,
+        m_shareContext ? m_shareContext->m_window : nullptr
+    );
+
+    if (!m_window)
+    {
+        EZWINDOW_ERROR("Cant create GLFW window");
+        return;
+    }
+
+#ifdef EZWINDOW_OPENGL
+    glfwMakeContextCurrent(m_window);
+    glewExperimental = GL_TRUE;
+
+    // OSMesa context has no GLX display, 'glewInit' would fail in its GLX extensions part
+    const bool osmesa = glfwGetWindowAttrib(m_window, GLFW_CONTEXT_CREATION_API) == GLFW_OSMESA_CONTEXT_API;
+
+    GLenum GLEWInitResult = osmesa ? glewContextInit() : glewInit();
+    if (GLEWInitResult != GLEW_OK)
+    {
+        EZWINDOW_ERROR(glewGetErrorString(GLEWInitResult));
+
+        if (osmesa)
+        {
+            EZWINDOW_ERROR("GLEW cant load OpenGL functions of OSMesa context, run headless OpenGL on a display like Xvfb");
+        }
+
+        glfwDestroyWindow(m_window);
+        m_window = nullptr;
+        return;
+    }
+
+    m_swapTearSupported = glfwExtensionSupported("WGL_EXT_swap_control_tear") ||
+                          glfwExtensionSupported("GLX_EXT_swap_control_tear");
+#endif
+
+#ifdef EZWINDOW_VULKAN
+    // Swapchain falls back to Fifo if relaxed Fifo is not supported
+    m_swapTearSupported = true;
+#endif
+
+    glfwSetWindowUserPointer(m_window, this);
+
+    m_monitorRate = monitorRefreshRate();
+
+    int framebufferWidth = 0;
+    int framebufferHeight = 0;
+    glfwGetFramebufferSize(m_window, &framebufferWidth, &framebufferHeight);
+    m_framebufferSize = {uint64_t(framebufferWidth), uint64_t(framebufferHeight)};
+
+    glfwGetWindowContentScale(m_window, &m_contentScale.x, &m_contentScale.y);
+
+    glfwSetWindowSizeCallback(m_window, [](GLFWwindow* window, int w, int h)
+    {
+        auto* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
+        self->postEvent({EEventType::Resize, w, h});
+    });
+
+    glfwSetFramebufferSizeCallback(m_window, [](GLFWwindow* window, int w, int h)
+    {
+        auto* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
+        self->postEvent({EEventType::Framebuffer, w, h});
+    });
+
+    glfwSetWindowContentScaleCallback(m_window, [](GLFWwindow* window, float x, float y)
+    {
+        auto* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
+        self->postEvent({EEventType::Scale, 0, 0, 0, x, y});
+    });
+
+    glfwSetWindowRefreshCallback(m_window, [](GLFWwindow* window)
+    {
+        auto* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
+        self->postEvent({EEventType::Refresh});
+    });
+
+    glfwSetWindowPosCallback(m_window, [](GLFWwindow* window, int, int)
+    {
+        auto* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
+        self->m_monitorRate = self->monitorRefreshRate();
+    });
+
+    if (m_eventMask & eventBit(EEventType::Key))
+    {
+        glfwSetKeyCallback(m_window, [](GLFWwindow* window, int key, int scancode, int action, int mods)
+        {
+            auto* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
+            self->postEvent({EEventType::Key, key, action, mods});
+        });
+    }
+
+    if (m_eventMask & eventBit(EEventType::MouseMove))
+    {
+        glfwSetCursorPosCallback(m_window, [](GLFWwindow* window, double x, double y)
+        {
+            auto* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
+            self->postEvent({EEventType::MouseMove, 0, 0, 0, x, y});
+        });
+    }
+
+    if (m_eventMask & eventBit(EEventType::MouseArea))
+    {
+        glfwSetCursorEnterCallback(m_window, [](GLFWwindow* window, int entered)
+        {
+            auto* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
+            self->postEvent({EEventType::MouseArea, entered});
+        });
+    }
+
+    if (m_eventMask & eventBit(EEventType::Button))
+    {
+        glfwSetMouseButtonCallback(m_window, [](GLFWwindow* window, int button, int action, int mods)
+        {
+            auto* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
+            self->postEvent({EEventType::Button, button, action, mods});
+        });
+    }
+
+    if (m_eventMask & eventBit(EEventType::Scroll))
+    {
+        glfwSetScrollCallback(m_window, [](GLFWwindow* window, double x, double y)
+        {
+            auto* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
+            self->postEvent({EEventType::Scroll, 0, 0, 0, x, y});
+        });
+    }
+
+    // Input modes requested before creation
+    if (m_cursorLocked)
+    {
+        glfwSetInputMode(m_window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+    }
+
+    if (m_rawMouseMotion)
+    {
+        glfwSetInputMode(m_window, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
+    }
+
+    // Mode requested before creation is resolved against extensions known only now
+    if (m_swapPending)
+    {
+        m_swap.setMode(m_swap.mode(), m_swapTearSupported);
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
 void
 Window::run()
 {
     if (!m_window)
     {
         EZWINDOW_ERROR("Cant start window event loop. GLFW window was not created.");
+        return;
+    }
+
+    m_monitorRate = monitorRefreshRate();
+    sampleCursor();
+
+    if (m_threadedRendering)
+    {
+        runThreaded();
+        return;
     }
 
     beforeLoop();
 
-    glfwSetTime(0.0);
+    m_clock.reset(nowNanoseconds());
+    updateFramePacing();
+    m_pacer.reset();
 
     while (!glfwWindowShouldClose(m_window))
     {
-        m_time = glfwGetTime();
-        m_curr_tick = m_time - m_prev_tick;
-        m_prev_tick = m_time;
+        pollEvents();
 
+        if (frame())
+        {
+            paceFrame();
+        }
+    }
+
+    endLoop();
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::runFrames(std::uint64_t count, double timeStep)
+{
+    if (!m_window)
+    {
+        EZWINDOW_ERROR("Cant run window frames. GLFW window was not created.");
+        return;
+    }
+
+    // Stepping is often repeated, don't pay the cursor round trip every time
+    if (!m_cursorKnown)
+    {
+        sampleCursor();
+    }
+
+    beforeLoop();
+
+    m_clock.reset(nowNanoseconds());
+    m_timeStep = timeStep;
+
+    for (std::uint64_t i = 0; i < count; ++i)
+    {
+        const auto pollStart = nowNanoseconds();
         glfwPollEvents();
+        recordPhase(EFramePhase::Poll, pollStart, nowNanoseconds() - pollStart);
 
-        tickEvent();
-        clearEvent();
-        renderEvent();
+        markDirty();
+        frame();
     }
 
-    afterLoop();
+    m_timeStep = 0.0;
+
+    endLoop();
 }
 
 /* --------------------------------------------------------------------------------------- */
@@ -372,52 +1061,946 @@ void
 Window::close()
 {
     glfwSetWindowShouldClose(m_window, true);
+
+    if (m_renderThreadActive.load(std::memory_order_acquire))
+    {
+        glfwPostEmptyEvent();
+    }
 }
 
 /* --------------------------------------------------------------------------------------- */
 
 void
-Window::swapFrameBuffers()
+Window::requestRedraw()
 {
-    glfwSwapBuffers(m_window);
+    markDirty();
+    glfwPostEmptyEvent();
+
+    if (m_renderThreadActive.load(std::memory_order_acquire))
+    {
+        wakeRenderThread();
+    }
 }
 
 /* --------------------------------------------------------------------------------------- */
 
-EState
-Window::buttonState(EButton button)
+void
+Window::injectEvent(Event event)
 {
-    auto val = glfwGetMouseButton(m_window, size_t(button));
-    return *reinterpret_cast<const EState*>(&val);
+    event.timestamp = nowNanoseconds();
+    enqueueEvent(event);
 }
 
 /* --------------------------------------------------------------------------------------- */
 
-EState
-Window::keyState(EKey key)
+void
+Window::injectKey(EKey key, EState state, EModifier modifier)
 {
-    auto val = glfwGetKey(m_window, size_t(key));
-    return *reinterpret_cast<const EState*>(&val);
+    injectEvent({EEventType::Key, std::int32_t(key), std::int32_t(state), std::int32_t(modifier)});
 }
 
-/* ####################################################################################### */
-/* Window events */
-/* ####################################################################################### */
+/* --------------------------------------------------------------------------------------- */
 
 void
-Window::beforeLoop()
+Window::injectButton(EButton button, EState state, EModifier modifier)
 {
+    injectEvent({EEventType::Button, std::int32_t(button), std::int32_t(state), std::int32_t(modifier)});
+}
+
+/* --------------------------------------------------------------------------------------- */
 
+void
+Window::injectMouseMove(Vector<double> position)
+{
+    injectEvent({EEventType::MouseMove, 0, 0, 0, position.x, position.y});
 }
 
 /* --------------------------------------------------------------------------------------- */
 
 void
-Window::tickEvent()
+Window::injectScroll(Vector<double> offset)
 {
-    m_prev_tick_mouse_pos.intValue      = mousePosition();
-    m_prev_tick_mouse_pos.rel01Value    = relative01<double>(mousePosition());
-    m_prev_tick_mouse_pos.rel11Value    = relative<double>(mousePosition());
+    injectEvent({EEventType::Scroll, 0, 0, 0, offset.x, offset.y});
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::injectResize(const Size<uint64_t>& size)
+{
+    const double ratioX = m_size.w > 0 ? double(m_framebufferSize.w) / double(m_size.w) : 1.0;
+    const double ratioY = m_size.h > 0 ? double(m_framebufferSize.h) / double(m_size.h) : 1.0;
+
+    injectEvent({EEventType::Resize, std::int32_t(size.w), std::int32_t(size.h)});
+    injectEvent({EEventType::Framebuffer, std::int32_t(double(size.w) * ratioX), std::int32_t(double(size.h) * ratioY)});
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+FrameAwaiter
+Window::nextFrame()
+{
+    return {*this, TaskWait{ETaskWait::Frame}};
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+FrameAwaiter
+Window::seconds(double duration)
+{
+    return {*this, TaskWait{ETaskWait::Time, time() + duration}};
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+FrameAwaiter
+Window::nextKey(EKey key, EState state)
+{
+    return {*this, TaskWait{ETaskWait::Event, 0.0, EEventType::Key, std::int32_t(key), std::int32_t(state)}};
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+FrameAwaiter
+Window::nextButton(EButton button, EState state)
+{
+    return {*this, TaskWait{ETaskWait::Event, 0.0, EEventType::Button, std::int32_t(button), std::int32_t(state)}};
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::swapFrameBuffers()
+{
+    const auto start = nowNanoseconds();
+
+#ifdef EZWINDOW_OPENGL
+    // Readback is only queued, finished ones are handed to capture writer
+    if (m_capture)
+    {
+        m_capture->readBack(std::uint32_t(m_framebufferSize.w), std::uint32_t(m_framebufferSize.h));
+    }
+
+    // Waiting for GPU to release next stream region is counted as a part of swap
+    if (m_streamBuffer)
+    {
+        m_streamBuffer->endFrame();
+    }
+#endif
+
+    glfwSwapBuffers(m_window);
+    recordSwap(start, nowNanoseconds() - start);
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::recordSwap(std::uint64_t start, std::uint64_t duration)
+{
+    recordPhase(EFramePhase::Swap, start, duration);
+    m_swapDuration += duration;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+EState
+Window::buttonState(EButton button)
+{
+    return m_input.isDown(button) ? EState::Press : EState::Release;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+EState
+Window::keyState(EKey key)
+{
+    return m_input.isDown(key) ? EState::Press : EState::Release;
+}
+
+/* ####################################################################################### */
+/* Internals */
+/* ####################################################################################### */
+
+bool
+Window::acquirePlatform()
+{
+    std::lock_guard<std::mutex> lock(platformMutex);
+
+    if (platformUsers == 0)
+    {
+        if (preloadThread.joinable())
+        {
+            preloadThread.join();
+        }
+
+#ifdef GLFW_PLATFORM_NULL
+        if (headlessMode && headlessNullPlatform())
+        {
+            glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+        }
+        else
+        {
+            glfwInitHint(GLFW_PLATFORM, GLFW_ANY_PLATFORM);
+        }
+#endif
+        if (glfwInit() != GLFW_TRUE)
+        {
+            return false;
+        }
+    }
+
+    ++platformUsers;
+    return true;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::releasePlatform()
+{
+    std::lock_guard<std::mutex> lock(platformMutex);
+
+    if (platformUsers > 0 && --platformUsers == 0)
+    {
+        glfwTerminate();
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::preloadPlatform()
+{
+    std::lock_guard<std::mutex> lock(platformMutex);
+
+    if (platformUsers == 0 && !preloadThread.joinable())
+    {
+        // Headless windows on a display still need window system libraries
+#ifdef GLFW_PLATFORM_NULL
+        const bool nullPlatform = headlessMode && headlessNullPlatform();
+#else
+        const bool nullPlatform = false;
+#endif
+        static_cast<std::thread&>(preloadThread) = std::thread(preloadLibraries, nullPlatform);
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::setHeadless(bool enabled)
+{
+    headlessMode = enabled;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+bool
+Window::headless()
+{
+    return headlessMode;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::setDefaultShareContext(Window* window)
+{
+    defaultShareContext = window;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+bool
+Window::frame()
+{
+    if (m_timeStep > 0.0)
+    {
+        m_clock.step(std::uint64_t(m_timeStep * 1e9 + 0.5));
+    }
+    else
+    {
+        m_clock.tick(nowNanoseconds());
+    }
+
+    updateSwapInterval();
+
+    auto start = nowNanoseconds();
+    auto end = start;
+
+    drainEvents();
+    end = nowNanoseconds();
+    recordPhase(EFramePhase::Dispatch, start, end - start);
+    start = end;
+
+    // Jobs of previous frame could overlap its render and swap
+    if (m_jobs)
+    {
+        m_jobs->beginFrame();
+    }
+
+#ifdef EZWINDOW_OPENGL
+    for (const auto& context : m_uploadContexts)
+    {
+        context->collect();
+    }
+#endif
+
+    resumeTasks();
+    tickEvent();
+
+    const bool render = m_loopMode == ELoopMode::Continuous || m_redraw.exchange(false, std::memory_order_acq_rel);
+
+    // Waiting for jobs rendering depends on is a part of tick
+    if (render && m_jobs)
+    {
+        m_jobs->waitForRender();
+    }
+
+    end = nowNanoseconds();
+    recordPhase(EFramePhase::Tick, start, end - start);
+    start = end;
+
+    if (render)
+    {
+        clearEvent();
+        end = nowNanoseconds();
+        recordPhase(EFramePhase::Clear, start, end - start);
+        start = end;
+
+        // Swap is usually called from render handler, it is measured separately
+        m_swapDuration = 0;
+        renderEvent();
+        end = nowNanoseconds();
+        m_stats.record(EFramePhase::Render, end - start - std::min(end - start, m_swapDuration));
+
+        m_lastSwapDuration = m_swapDuration;
+        m_presented = m_swapDuration > 0;
+
+        if (Trace::enabled())
+        {
+            // Trace keeps swap nested into render
+            Trace::record(FrameStats::phaseName(EFramePhase::Render), start, end - start);
+        }
+
+        return true;
+    }
+
+    m_presented = false;
+
+    return false;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::paceFrame()
+{
+    updateFramePacing();
+
+    if (m_pacer.targetRate() > 0.0)
+    {
+        const auto start = nowNanoseconds();
+        m_pacer.wait();
+        recordPhase(EFramePhase::Wait, start, nowNanoseconds() - start);
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::recordPhase(EFramePhase phase, std::uint64_t start, std::uint64_t duration)
+{
+    m_stats.record(phase, duration);
+
+    if (Trace::enabled())
+    {
+        Trace::record(FrameStats::phaseName(phase), start, duration);
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::endLoop()
+{
+    afterLoop();
+
+    if (!m_statsPath.empty() && !m_stats.write(m_statsPath))
+    {
+        EZWINDOW_WARNING("Cant write frame stats to " << m_statsPath);
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::runThreaded()
+{
+#ifdef EZWINDOW_OPENGL
+    // Context is owned by render thread while loop is running
+    glfwMakeContextCurrent(nullptr);
+#endif
+
+    m_renderThreadActive.store(true, std::memory_order_release);
+
+    std::thread renderThread([this]{ renderLoop(); });
+
+    // Main thread only pumps events, callbacks forward them to render thread
+    while (!glfwWindowShouldClose(m_window))
+    {
+        glfwWaitEvents();
+
+        if (m_loopMode == ELoopMode::OnDemand)
+        {
+            wakeRenderThread();
+        }
+    }
+
+    wakeRenderThread();
+    renderThread.join();
+
+#ifdef EZWINDOW_OPENGL
+    glfwMakeContextCurrent(m_window);
+#endif
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::renderLoop()
+{
+    if (Trace::enabled())
+    {
+        Trace::setThreadName("EasyWindow render");
+    }
+
+#ifdef EZWINDOW_OPENGL
+    glfwMakeContextCurrent(m_window);
+#endif
+
+    beforeLoop();
+
+    m_clock.reset(nowNanoseconds());
+    updateFramePacing();
+    m_pacer.reset();
+
+    while (!glfwWindowShouldClose(m_window))
+    {
+        if (m_loopMode == ELoopMode::OnDemand)
+        {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+
+            const auto ready = [this]
+            {
+                return m_redraw.load(std::memory_order_acquire) || !m_events.empty() || glfwWindowShouldClose(m_window);
+            };
+
+            m_waited = !ready();
+
+            const double timeout = eventWaitTimeout();
+
+            if (timeout > 0.0)
+            {
+                m_wakeCondition.wait_for(lock, std::chrono::duration<double>(timeout), ready);
+            }
+            else
+            {
+                m_wakeCondition.wait(lock, ready);
+            }
+        }
+
+        if (frame())
+        {
+            paceFrame();
+        }
+    }
+
+    endLoop();
+
+#ifdef EZWINDOW_OPENGL
+    glfwMakeContextCurrent(nullptr);
+#endif
+
+    m_renderThreadActive.store(false, std::memory_order_release);
+
+    // Main thread may sleep in glfwWaitEvents
+    glfwPostEmptyEvent();
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::wakeRenderThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+    }
+    m_wakeCondition.notify_one();
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::postEvent(Event event)
+{
+    event.timestamp = nowNanoseconds();
+
+    if (m_recorder)
+    {
+        m_recorder->record(event);
+    }
+
+    enqueueEvent(event);
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::enqueueEvent(const Event& event)
+{
+    while (!m_events.push(event))
+    {
+        // Without render thread nobody drains the ring until next tick
+        if (!m_renderThreadActive.load(std::memory_order_acquire))
+        {
+            m_droppedEvents.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        wakeRenderThread();
+        std::this_thread::yield();
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::drainEvents()
+{
+    m_frameEventsCount = 0;
+
+    m_events.consume([this](const Event& event)
+    {
+        m_frameEvents[m_frameEventsCount++] = event;
+    });
+
+    if (m_replay)
+    {
+        const auto now = nowNanoseconds();
+
+        for (const auto& event : m_replay->advance(time(), EventsCapacity - m_frameEventsCount))
+        {
+            m_frameEvents[m_frameEventsCount] = event;
+            m_frameEvents[m_frameEventsCount].timestamp = now;
+            ++m_frameEventsCount;
+        }
+    }
+
+    m_input.beginFrame();
+    m_motion.delta = {0.0};
+    m_motion.samples = 0;
+    m_motionHistoryCount = 0;
+
+    for (std::size_t i = 0; i < m_frameEventsCount; ++i)
+    {
+        const Event& event = m_frameEvents[i];
+
+        EZWINDOW_TRACE_SCOPE(eventName(event.type))
+
+        if (event.type == EEventType::MouseMove)
+        {
+            trackMotion(event);
+
+            // Motion is merged up to the next non motion event, so buttons
+            // and keys still see the cursor where it was at their moment.
+            const bool merged =
+                m_coalesceMotion &&
+                i + 1 < m_frameEventsCount &&
+                m_frameEvents[i + 1].type == EEventType::MouseMove;
+
+            if (merged)
+            {
+                continue;
+            }
+        }
+
+        dispatchEvent(event);
+    }
+
+    if (m_resized)
+    {
+        m_resized = false;
+
+#ifdef EZWINDOW_VULKAN
+        if (m_swapchain)
+        {
+            m_swapchain->resize({std::uint32_t(m_framebufferSize.w), std::uint32_t(m_framebufferSize.h)});
+        }
+#endif
+
+        // Resize event stands for coalesced size, framebuffer and scale change
+        EZWINDOW_TRACE_SCOPE(eventName(EEventType::Resize))
+        m_dispatch(*this, Event{EEventType::Resize});
+    }
+
+    double ys[2] = {m_cursor.y, m_size.h - m_cursor.y};
+    m_mousePosition = {uint64_t(m_cursor.x), uint64_t(ys[uint8_t(m_originCorner)])};
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::sampleCursor()
+{
+    // The only cursor round trips, later cursor state is built from events
+    glfwGetCursorPos(m_window, &m_cursor.x, &m_cursor.y);
+    m_cursorInside = bool(glfwGetWindowAttrib(m_window, GLFW_HOVERED));
+    m_cursorKnown = true;
+
+    double ys[2] = {m_cursor.y, m_size.h - m_cursor.y};
+    m_mousePosition = {uint64_t(m_cursor.x), uint64_t(ys[uint8_t(m_originCorner)])};
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::trackMotion(const Event& event)
+{
+    const double sign = m_originCorner == EOriginCorner::TopLeft ? 1.0 : -1.0;
+
+    if (m_cursorKnown)
+    {
+        m_motion.delta.x += event.x - m_cursor.x;
+        m_motion.delta.y += (event.y - m_cursor.y) * sign;
+    }
+
+    m_cursor = {event.x, event.y};
+    m_cursorKnown = true;
+
+    double ys[2] = {event.y, m_size.h - event.y};
+    m_motion.position = {event.x, ys[uint8_t(m_originCorner)]};
+    m_motion.samples += 1;
+
+    if (m_motionHistoryCount < m_motionHistory.size())
+    {
+        m_motionHistory[m_motionHistoryCount++] = {m_motion.position, event.timestamp};
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::dispatchEvent(const Event& event)
+{
+    switch (event.type)
+    {
+        case EEventType::Resize:
+        {
+            // Window already has this size, so don't call glfwSetWindowSize again.
+            // Drag produces many sizes per tick, handler is called once for the last.
+            m_size = {uint64_t(event.code), uint64_t(event.action)};
+            m_resized = true;
+            markDirty();
+            return;
+        }
+        case EEventType::Framebuffer:
+        {
+            m_framebufferSize = {uint64_t(event.code), uint64_t(event.action)};
+            m_resized = true;
+            markDirty();
+            return;
+        }
+        case EEventType::Scale:
+        {
+            m_contentScale = {float(event.x), float(event.y)};
+            m_resized = true;
+            markDirty();
+            return;
+        }
+        case EEventType::Key:
+        {
+            m_input.setKey(event.key(), event.state());
+            break;
+        }
+        case EEventType::MouseArea:
+        {
+            m_cursorInside = event.code != 0;
+            break;
+        }
+        case EEventType::Button:
+        {
+            m_input.setButton(event.button(), event.state());
+            break;
+        }
+        case EEventType::Refresh:
+        case EEventType::MouseMove:
+        case EEventType::Scroll:
+        {
+            break;
+        }
+    }
+
+    m_dispatch(*this, event);
+    markDirty();
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::dispatchHandlers(Window& window, const Event& event)
+{
+    switch (event.type)
+    {
+        case EEventType::Resize:
+        {
+            window.resizeEvent();
+            break;
+        }
+        case EEventType::Key:
+        {
+            window.keyEvent(event.key(), event.state(), event.modifier());
+            break;
+        }
+        case EEventType::MouseArea:
+        {
+            window.mouseAreaEvent(event.code != 0);
+            break;
+        }
+        case EEventType::MouseMove:
+        {
+            window.mouseMoveEvent(window.eventPosition(event));
+            break;
+        }
+        case EEventType::Button:
+        {
+            window.buttonEvent(event.button(), event.state(), event.modifier());
+            break;
+        }
+        case EEventType::Scroll:
+        {
+            window.scrollEvent(Vector<double>{event.x, event.y});
+            break;
+        }
+        case EEventType::Refresh:
+        case EEventType::Framebuffer:
+        case EEventType::Scale:
+        {
+            break;
+        }
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::pollEvents()
+{
+    if (m_loopMode == ELoopMode::Continuous || m_redraw.load(std::memory_order_acquire))
+    {
+        // Waiting for events is idle time, only polling is measured
+        const auto start = nowNanoseconds();
+        glfwPollEvents();
+        recordPhase(EFramePhase::Poll, start, nowNanoseconds() - start);
+    }
+    else
+    {
+        const double timeout = eventWaitTimeout();
+
+        if (timeout > 0.0)
+        {
+            glfwWaitEventsTimeout(timeout);
+        }
+        else
+        {
+            glfwWaitEvents();
+        }
+
+        m_waited = true;
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+double
+Window::eventWaitTimeout() const
+{
+    double timeout = m_idleTimeout;
+
+    const auto limit = [&timeout](double seconds)
+    {
+        // Passed deadline still needs positive timeout, zero one means no timeout
+        seconds = std::max(seconds, 1e-6);
+        timeout = timeout > 0.0 ? std::min(timeout, seconds) : seconds;
+    };
+
+    for (const auto& [wait, task] : m_tasks)
+    {
+        if (wait.kind == ETaskWait::Frame)
+        {
+            limit(0.0);
+        }
+        else if (wait.kind == ETaskWait::Time)
+        {
+            limit(wait.time - time());
+        }
+    }
+
+#ifdef EZWINDOW_OPENGL
+    for (const auto& context : m_uploadContexts)
+    {
+        if (context->pending() > 0)
+        {
+            limit(uploadPollInterval);
+            break;
+        }
+    }
+#endif
+
+    return timeout;
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::updateFramePacing()
+{
+    double rate = 0.0;
+
+    switch (m_pacing)
+    {
+        case EFramePacing::Unlimited:   rate = 0.0; break;
+        case EFramePacing::TargetRate:  rate = m_targetRate; break;
+        case EFramePacing::MonitorRate: rate = m_monitorRate.load(std::memory_order_relaxed); break;
+    }
+
+    if (rate != m_pacer.targetRate())
+    {
+        m_pacer.setTargetRate(rate);
+    }
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::updateSwapInterval()
+{
+    // Only back to back presented frames tell how swap interval affects frame rate,
+    // synthetic time of 'runFrames' tells nothing and time spent waiting for events
+    // is not a missed vblank
+    if (m_presented && !m_waited && m_timeStep == 0.0)
+    {
+        const double idle = double(m_lastSwapDuration) * 1e-9 + m_pacer.lastWait();
+        m_swapPending |= m_swap.update(tickDelta(), idle, m_monitorRate.load(std::memory_order_relaxed));
+    }
+
+    m_waited = false;
+
+    if (!m_swapPending)
+    {
+        return;
+    }
+
+    m_swapPending = false;
+
+#ifdef EZWINDOW_OPENGL
+    glfwSwapInterval(m_swap.interval());
+#elif defined(EZWINDOW_VULKAN)
+    if (m_swapchain)
+    {
+        const EPresentMode modes[] = {EPresentMode::FifoRelaxed, EPresentMode::Immediate, EPresentMode::Fifo};
+        m_swapchain->setPresentMode(modes[m_swap.interval() + 1]);
+    }
+#endif
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::suspendTask(const TaskWait& wait, const SuspendedTask& task)
+{
+    m_tasks.emplace_back(wait, task);
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::resumeTasks()
+{
+    if (m_tasks.empty())
+    {
+        return;
+    }
+
+    // Tasks suspended again while resuming wait for the next frame, they go to fresh list
+    m_resumedTasks.swap(m_tasks);
+
+    for (const auto& [wait, task] : m_resumedTasks)
+    {
+        bool ready = false;
+
+        switch (wait.kind)
+        {
+            case ETaskWait::Frame:
+            {
+                ready = true;
+                break;
+            }
+            case ETaskWait::Time:
+            {
+                ready = time() >= wait.time;
+                break;
+            }
+            case ETaskWait::Event:
+            {
+                for (const auto& event : frameEvents())
+                {
+                    if (event.type == wait.type && event.code == wait.code && event.action == wait.action)
+                    {
+                        *task.event = event;
+                        ready = true;
+                        break;
+                    }
+                }
+                break;
+            }
+        }
+
+        if (ready)
+        {
+            // Task changes state during tick, OnDemand frame has to show it
+            markDirty();
+            task.resume(task.handle);
+        }
+        else
+        {
+            m_tasks.emplace_back(wait, task);
+        }
+    }
+
+    m_resumedTasks.clear();
+}
+
+/* ####################################################################################### */
+/* Window events */
+/* ####################################################################################### */
+
+void
+Window::beforeLoop()
+{
+
+}
+
+/* --------------------------------------------------------------------------------------- */
+
+void
+Window::tickEvent()
+{
+    const auto position = mousePosition();
+
+    m_prev_tick_mouse_pos.intValue      = position;
+    m_prev_tick_mouse_pos.rel01Value    = relative01<double>(position);
+    m_prev_tick_mouse_pos.rel11Value    = relative<double>(position);
 }
 
 /* --------------------------------------------------------------------------------------- */